@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace OpenLoco::Core
+{
+    // 64-bit non-cryptographic hash (XXH64), processes 32 bytes per round in four independent
+    // lanes so it runs at memory bandwidth. The result is the same on every platform and can
+    // be chained by passing a previous result as the seed.
+    uint64_t hash64(const void* data, size_t length, uint64_t seed = 0);
+
+    template<typename T>
+    uint64_t hashValue(const T& value, uint64_t seed = 0)
+    {
+        return hash64(&value, sizeof(T), seed);
+    }
+
+    // Streaming form of hash64, the digest equals hash64 over all the updated data concatenated.
+    // Lets many small pieces be hashed without first copying them into one buffer.
+    class Hasher64
+    {
+    private:
+        uint64_t _seed;
+        uint64_t _lanes[4];
+        uint64_t _length = 0;
+        uint8_t _buffer[32];
+        size_t _bufferSize = 0;
+
+    public:
+        explicit Hasher64(uint64_t seed = 0);
+
+        void update(const void* data, size_t length);
+
+        template<typename T>
+        void updateValue(const T& value)
+        {
+            update(&value, sizeof(T));
+        }
+
+        uint64_t digest() const;
+    };
+}
@@ -1,23 +1,109 @@
 #pragma once
 
+#include "Numerics.hpp"
+#include <array>
+#include <cstdint>
 #include <iterator>
 
 namespace OpenLoco
 {
+    // Marks which slots of a FixedVector may be in use so iterating does not have to check every slot.
+    // A set bit for an empty slot is allowed, every slot in use must however have its bit set.
+    template<size_t Count>
+    class OccupancyMask
+    {
+    private:
+        static constexpr size_t kBitsPerWord = 64;
+        static constexpr size_t kWordCount = (Count + kBitsPerWord - 1) / kBitsPerWord;
+
+        std::array<uint64_t, kWordCount> _words{};
+
+    public:
+        constexpr void set(size_t index)
+        {
+            _words[index / kBitsPerWord] |= 1ULL << (index % kBitsPerWord);
+        }
+
+        constexpr void reset(size_t index)
+        {
+            _words[index / kBitsPerWord] &= ~(1ULL << (index % kBitsPerWord));
+        }
+
+        constexpr void clear()
+        {
+            _words.fill(0);
+        }
+
+        [[nodiscard]] constexpr bool test(size_t index) const
+        {
+            return (_words[index / kBitsPerWord] & (1ULL << (index % kBitsPerWord))) != 0;
+        }
+
+        // Sets exactly the bits of the slots that are not empty.
+        template<typename ValueType>
+        void assign(const ValueType (&arr)[Count])
+        {
+            clear();
+            for (size_t i = 0; i < Count; ++i)
+            {
+                if (!arr[i].empty())
+                {
+                    set(i);
+                }
+            }
+        }
+
+        // Returns the first set index at or after index, or Count if there is none.
+        [[nodiscard]] size_t findNext(size_t index) const
+        {
+            if (index >= Count)
+            {
+                return Count;
+            }
+
+            auto wordIndex = index / kBitsPerWord;
+            auto word = _words[wordIndex] & (~0ULL << (index % kBitsPerWord));
+            while (word == 0)
+            {
+                if (++wordIndex == kWordCount)
+                {
+                    return Count;
+                }
+                word = _words[wordIndex];
+            }
+            // Bits beyond Count are never set.
+            return wordIndex * kBitsPerWord + Numerics::bitScanForward64(word);
+        }
+    };
+
     template<typename ValueType, size_t Count>
     class FixedVector
     {
     private:
         ValueType* startAddress = nullptr;
+        const OccupancyMask<Count>* occupancy = nullptr;
 
         class Iter
         {
         private:
             ValueType* arr;
+            const OccupancyMask<Count>* mask;
             size_t i = 0;
 
             constexpr void findNonEmpty()
             {
+                if (mask != nullptr)
+                {
+                    for (i = mask->findNext(i); i < Count; i = mask->findNext(i + 1))
+                    {
+                        if (!arr[i].empty())
+                        {
+                            break;
+                        }
+                    }
+                    return;
+                }
+
                 for (; i < Count; ++i)
                 {
                     if (!arr[i].empty())
@@ -28,8 +114,9 @@ namespace OpenLoco
             }
 
         public:
-            constexpr Iter(ValueType* _arr, size_t _index)
+            constexpr Iter(ValueType* _arr, const OccupancyMask<Count>* _mask, size_t _index)
                 : arr(_arr)
+                , mask(_mask)
                 , i(_index)
             {
                 // finds first valid entry
@@ -77,13 +164,20 @@ namespace OpenLoco
         {
         }
 
+        // Only visits the slots set in the mask, the mask must outlive the vector.
+        FixedVector(ValueType (&_arr)[Count], const OccupancyMask<Count>& _occupancy)
+            : startAddress(_arr)
+            , occupancy(&_occupancy)
+        {
+        }
+
         Iter begin() const
         {
-            return Iter(startAddress, 0);
+            return Iter(startAddress, occupancy, 0);
         }
         Iter end() const
         {
-            return Iter(startAddress, Count);
+            return Iter(startAddress, occupancy, Count);
         }
 
         [[nodiscard]] bool empty() const
@@ -12,6 +12,8 @@ namespace OpenLoco::Numerics
 
     int32_t bitScanReverse(uint32_t source);
 
+    int32_t bitScanForward64(uint64_t source);
+
     template<typename _UIntType>
     static constexpr _UIntType rol(_UIntType x, size_t shift)
     {
@@ -0,0 +1,173 @@
+#include "Hash.h"
+#include "Numerics.hpp"
+#include <cstring>
+
+namespace OpenLoco::Core
+{
+    constexpr uint64_t kPrime1 = 0x9E3779B185EBCA87ULL;
+    constexpr uint64_t kPrime2 = 0xC2B2AE3D27D4EB4FULL;
+    constexpr uint64_t kPrime3 = 0x165667B19E3779F9ULL;
+    constexpr uint64_t kPrime4 = 0x85EBCA77C2B2AE63ULL;
+    constexpr uint64_t kPrime5 = 0x27D4EB2F165667C5ULL;
+
+    // Reads are always little endian so the hash does not depend on the platform.
+    static uint64_t read64(const uint8_t* p)
+    {
+        uint64_t value;
+        std::memcpy(&value, p, sizeof(value));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        value = __builtin_bswap64(value);
+#endif
+        return value;
+    }
+
+    static uint32_t read32(const uint8_t* p)
+    {
+        uint32_t value;
+        std::memcpy(&value, p, sizeof(value));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        value = __builtin_bswap32(value);
+#endif
+        return value;
+    }
+
+    static uint64_t round(uint64_t acc, uint64_t input)
+    {
+        acc += input * kPrime2;
+        acc = Numerics::rol(acc, 31);
+        return acc * kPrime1;
+    }
+
+    static uint64_t mergeRound(uint64_t acc, uint64_t value)
+    {
+        acc ^= round(0, value);
+        return acc * kPrime1 + kPrime4;
+    }
+
+    // Mixes in the bytes that did not fill a whole round and avalanches the result.
+    static uint64_t finalise(uint64_t h, const uint8_t* p, const uint8_t* end)
+    {
+        for (; p + 8 <= end; p += 8)
+        {
+            h ^= round(0, read64(p));
+            h = Numerics::rol(h, 27) * kPrime1 + kPrime4;
+        }
+        if (p + 4 <= end)
+        {
+            h ^= static_cast<uint64_t>(read32(p)) * kPrime1;
+            h = Numerics::rol(h, 23) * kPrime2 + kPrime3;
+            p += 4;
+        }
+        for (; p < end; p++)
+        {
+            h ^= *p * kPrime5;
+            h = Numerics::rol(h, 11) * kPrime1;
+        }
+
+        h ^= h >> 33;
+        h *= kPrime2;
+        h ^= h >> 29;
+        h *= kPrime3;
+        h ^= h >> 32;
+        return h;
+    }
+
+    static void initLanes(uint64_t (&lanes)[4], uint64_t seed)
+    {
+        lanes[0] = seed + kPrime1 + kPrime2;
+        lanes[1] = seed + kPrime2;
+        lanes[2] = seed;
+        lanes[3] = seed - kPrime1;
+    }
+
+    static void consumeRound(uint64_t (&lanes)[4], const uint8_t* p)
+    {
+        lanes[0] = round(lanes[0], read64(p));
+        lanes[1] = round(lanes[1], read64(p + 8));
+        lanes[2] = round(lanes[2], read64(p + 16));
+        lanes[3] = round(lanes[3], read64(p + 24));
+    }
+
+    static uint64_t mergeLanes(const uint64_t (&lanes)[4])
+    {
+        uint64_t h = Numerics::rol(lanes[0], 1) + Numerics::rol(lanes[1], 7) + Numerics::rol(lanes[2], 12) + Numerics::rol(lanes[3], 18);
+        h = mergeRound(h, lanes[0]);
+        h = mergeRound(h, lanes[1]);
+        h = mergeRound(h, lanes[2]);
+        h = mergeRound(h, lanes[3]);
+        return h;
+    }
+
+    uint64_t hash64(const void* data, size_t length, uint64_t seed)
+    {
+        const auto* p = static_cast<const uint8_t*>(data);
+        const auto* const end = p + length;
+
+        uint64_t h;
+        if (length >= 32)
+        {
+            uint64_t lanes[4];
+            initLanes(lanes, seed);
+
+            const auto* const limit = end - 32;
+            do
+            {
+                consumeRound(lanes, p);
+                p += 32;
+            } while (p <= limit);
+
+            h = mergeLanes(lanes);
+        }
+        else
+        {
+            h = seed + kPrime5;
+        }
+
+        h += static_cast<uint64_t>(length);
+        return finalise(h, p, end);
+    }
+
+    Hasher64::Hasher64(uint64_t seed)
+        : _seed(seed)
+    {
+        initLanes(_lanes, seed);
+    }
+
+    void Hasher64::update(const void* data, size_t length)
+    {
+        const auto* p = static_cast<const uint8_t*>(data);
+        const auto* const end = p + length;
+        _length += length;
+
+        if (_bufferSize + length < sizeof(_buffer))
+        {
+            std::memcpy(_buffer + _bufferSize, p, length);
+            _bufferSize += length;
+            return;
+        }
+
+        if (_bufferSize != 0)
+        {
+            const auto fill = sizeof(_buffer) - _bufferSize;
+            std::memcpy(_buffer + _bufferSize, p, fill);
+            consumeRound(_lanes, _buffer);
+            p += fill;
+            _bufferSize = 0;
+        }
+
+        for (; p + 32 <= end; p += 32)
+        {
+            consumeRound(_lanes, p);
+        }
+
+        _bufferSize = end - p;
+        std::memcpy(_buffer, p, _bufferSize);
+    }
+
+    uint64_t Hasher64::digest() const
+    {
+        uint64_t h = _length >= 32 ? mergeLanes(_lanes) : _seed + kPrime5;
+        h += _length;
+        return finalise(h, _buffer, _buffer + _bufferSize);
+    }
+}
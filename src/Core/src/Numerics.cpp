@@ -58,6 +58,27 @@ namespace OpenLoco::Numerics
             }
         }
         return -1;
+#endif
+    }
+
+    // Finds the first bit set in a 64-bits numeral and returns its index, or -1 if no bit is set.
+    int32_t bitScanForward64(uint64_t source)
+    {
+#if defined(_MSC_VER) && (_MSC_VER >= 1400) && defined(_M_X64)
+        unsigned long i;
+        uint8_t success = _BitScanForward64(&i, source);
+        return success != 0 ? i : -1;
+#elif defined(__GNUC__)
+        return source == 0 ? -1 : __builtin_ctzll(source);
+#else
+        // Also used by 32-bit MSVC which has no 64-bit intrinsic
+        const auto low = bitScanForward(static_cast<uint32_t>(source));
+        if (low != -1)
+        {
+            return low;
+        }
+        const auto high = bitScanForward(static_cast<uint32_t>(source >> 32));
+        return high != -1 ? high + 32 : -1;
 #endif
     }
 }
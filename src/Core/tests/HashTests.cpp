@@ -0,0 +1,82 @@
+#include <OpenLoco/Core/Hash.h>
+#include <algorithm>
+#include <array>
+#include <gtest/gtest.h>
+#include <string_view>
+
+using namespace OpenLoco;
+
+static uint64_t hashString(std::string_view str, uint64_t seed = 0)
+{
+    return Core::hash64(str.data(), str.size(), seed);
+}
+
+TEST(HashTests, knownValues)
+{
+    // Reference values of XXH64
+    EXPECT_EQ(hashString(""), 0xEF46DB3751D8E999ULL);
+    EXPECT_EQ(hashString("a"), 0xD24EC4F1A98C6E5BULL);
+    EXPECT_EQ(hashString("abc"), 0x44BC2CF5AD770999ULL);
+    EXPECT_EQ(hashString("Nobody inspects the spammish repetition"), 0xFBCEA83C8A378BF1ULL);
+}
+
+TEST(HashTests, seed)
+{
+    EXPECT_NE(hashString("abc", 0), hashString("abc", 1));
+    EXPECT_EQ(hashString("abc", 1), hashString("abc", 1));
+}
+
+TEST(HashTests, everyByteMatters)
+{
+    // Covers the 32 byte rounds as well as the 8, 4 and 1 byte tails.
+    std::array<uint8_t, 77> data{};
+    for (size_t i = 0; i < data.size(); i++)
+    {
+        data[i] = static_cast<uint8_t>(i);
+    }
+    const auto expected = Core::hash64(data.data(), data.size());
+    for (size_t i = 0; i < data.size(); i++)
+    {
+        data[i] ^= 1;
+        EXPECT_NE(Core::hash64(data.data(), data.size()), expected) << "byte " << i;
+        data[i] ^= 1;
+    }
+    EXPECT_EQ(Core::hash64(data.data(), data.size()), expected);
+}
+
+TEST(HashTests, value)
+{
+    const uint32_t value = 0x12345678;
+    EXPECT_EQ(Core::hashValue(value), Core::hash64(&value, sizeof(value)));
+}
+
+TEST(HashTests, streamingMatchesOneShot)
+{
+    std::array<uint8_t, 200> data{};
+    for (size_t i = 0; i < data.size(); i++)
+    {
+        data[i] = static_cast<uint8_t>(i * 31 + 7);
+    }
+    // Chunk sizes either side of the 32 byte round so the buffered and direct paths both run.
+    for (const size_t chunkSize : { 1, 3, 8, 31, 32, 33, 64, 200 })
+    {
+        for (size_t length = 0; length <= data.size(); length += 7)
+        {
+            Core::Hasher64 hasher(length);
+            for (size_t offset = 0; offset < length; offset += chunkSize)
+            {
+                hasher.update(data.data() + offset, std::min(chunkSize, length - offset));
+            }
+            EXPECT_EQ(hasher.digest(), Core::hash64(data.data(), length, length)) << "chunk " << chunkSize << " length " << length;
+        }
+    }
+}
+
+TEST(HashTests, streamingKnownValues)
+{
+    Core::Hasher64 hasher;
+    EXPECT_EQ(hasher.digest(), 0xEF46DB3751D8E999ULL);
+    hasher.update("ab", 2);
+    hasher.update("c", 1);
+    EXPECT_EQ(hasher.digest(), 0x44BC2CF5AD770999ULL);
+}
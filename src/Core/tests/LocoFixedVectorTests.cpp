@@ -0,0 +1,88 @@
+#include <OpenLoco/Core/LocoFixedVector.hpp>
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace OpenLoco;
+
+namespace
+{
+    struct Slot
+    {
+        int value;
+
+        bool empty() const { return value == 0; }
+    };
+
+    std::vector<int> collect(const FixedVector<Slot, 130>& vec)
+    {
+        std::vector<int> values;
+        for (auto& slot : vec)
+        {
+            values.push_back(slot.value);
+        }
+        return values;
+    }
+}
+
+TEST(LocoFixedVectorTest, occupancyFindNext)
+{
+    OccupancyMask<130> mask;
+    EXPECT_EQ(mask.findNext(0), 130U);
+
+    mask.set(0);
+    mask.set(63);
+    mask.set(64);
+    mask.set(129);
+    EXPECT_TRUE(mask.test(63));
+    EXPECT_FALSE(mask.test(62));
+
+    EXPECT_EQ(mask.findNext(0), 0U);
+    EXPECT_EQ(mask.findNext(1), 63U);
+    EXPECT_EQ(mask.findNext(64), 64U);
+    EXPECT_EQ(mask.findNext(65), 129U);
+    EXPECT_EQ(mask.findNext(130), 130U);
+
+    mask.reset(63);
+    EXPECT_EQ(mask.findNext(1), 64U);
+
+    mask.clear();
+    EXPECT_EQ(mask.findNext(0), 130U);
+}
+
+TEST(LocoFixedVectorTest, iterate)
+{
+    Slot slots[130]{};
+    slots[1].value = 1;
+    slots[70].value = 2;
+    slots[129].value = 3;
+
+    EXPECT_EQ(collect(FixedVector(slots)), (std::vector<int>{ 1, 2, 3 }));
+    EXPECT_EQ(FixedVector(slots).size(), 3U);
+}
+
+TEST(LocoFixedVectorTest, iterateWithOccupancy)
+{
+    Slot slots[130]{};
+    slots[1].value = 1;
+    slots[70].value = 2;
+    slots[129].value = 3;
+
+    OccupancyMask<130> mask;
+    mask.set(1);
+    mask.set(70);
+    mask.set(129);
+    // Stale bits of empty slots are skipped.
+    mask.set(5);
+    EXPECT_EQ(collect(FixedVector(slots, mask)), (std::vector<int>{ 1, 2, 3 }));
+
+    // Slots not in the mask are not visited.
+    mask.reset(70);
+    EXPECT_EQ(collect(FixedVector(slots, mask)), (std::vector<int>{ 1, 3 }));
+
+    mask.assign(slots);
+    EXPECT_EQ(collect(FixedVector(slots, mask)), (std::vector<int>{ 1, 2, 3 }));
+    EXPECT_FALSE(mask.test(5));
+
+    mask.clear();
+    EXPECT_TRUE(FixedVector(slots, mask).empty());
+}
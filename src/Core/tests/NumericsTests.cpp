@@ -25,6 +25,18 @@ TEST(NumericTest, bitScanReverse)
     EXPECT_EQ(Numerics::bitScanReverse(1u << 31), 31);
 }
 
+TEST(NumericTest, bitScanForward64)
+{
+    EXPECT_EQ(Numerics::bitScanForward64(0), -1);
+    EXPECT_EQ(Numerics::bitScanForward64(0b00000001), 0);
+    EXPECT_EQ(Numerics::bitScanForward64(0b10000010), 1);
+
+    EXPECT_EQ(Numerics::bitScanForward64(1ULL << 31), 31);
+    EXPECT_EQ(Numerics::bitScanForward64(1ULL << 32), 32);
+    EXPECT_EQ(Numerics::bitScanForward64((1ULL << 63) | (1ULL << 40)), 40);
+    EXPECT_EQ(Numerics::bitScanForward64(1ULL << 63), 63);
+}
+
 TEST(NumericTest, rol)
 {
     // rol is constexpr so all of the following could be done as static_asserts
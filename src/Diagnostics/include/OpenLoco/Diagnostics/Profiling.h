@@ -0,0 +1,98 @@
+#pragma once
+
+#include <OpenLoco/Core/FileSystem.hpp>
+#include <cstdint>
+#include <functional>
+
+namespace OpenLoco::Diagnostics::Profiling
+{
+    // Number of zones each thread keeps before the oldest ones are overwritten.
+    constexpr uint32_t kZonesPerThread = 1 << 16;
+
+    struct ZoneEvent
+    {
+        const char* name; // Must be a string with static storage duration.
+        uint64_t startNs;
+        uint64_t endNs;
+        uint32_t threadId;
+        uint16_t depth;
+    };
+
+    // Totals of every zone with the same name, unlike the ring buffers these are never overwritten.
+    struct ZoneStats
+    {
+        const char* name;
+        uint64_t count;
+        uint64_t totalNs;
+        uint64_t maxNs;
+    };
+
+    // Monotonic timestamp in nanoseconds.
+    uint64_t getTimestampNs();
+
+    // Zones are only recorded while profiling is enabled, a disabled zone costs a single branch.
+    void setEnabled(bool enabled);
+    bool isEnabled();
+
+    // Discards all recorded zones and statistics of every thread.
+    void reset();
+
+    // Invokes the callback for every zone still held in the ring buffers, oldest first per thread.
+    // Must not be called while other threads are recording.
+    void forEachZone(const std::function<void(const ZoneEvent&)>& callback);
+
+    // Invokes the callback for the statistics of each zone name, merged across all threads.
+    // Must not be called while other threads are recording.
+    void forEachZoneStats(const std::function<void(const ZoneStats&)>& callback);
+
+    // Writes all recorded zones in the Chrome trace event format, which can be opened
+    // with chrome://tracing or https://ui.perfetto.dev
+    bool exportChromeTrace(const fs::path& path);
+
+    namespace Detail
+    {
+        void enterZone();
+        void leaveZone(const char* name, uint64_t startNs);
+    }
+
+    class ScopedZone
+    {
+    private:
+        const char* _name;
+        uint64_t _startNs;
+
+    public:
+        explicit ScopedZone(const char* name)
+            : _name(nullptr)
+            , _startNs(0)
+        {
+            if (!isEnabled())
+            {
+                return;
+            }
+            _name = name;
+            Detail::enterZone();
+            _startNs = getTimestampNs();
+        }
+
+        ~ScopedZone()
+        {
+            if (_name != nullptr)
+            {
+                Detail::leaveZone(_name, _startNs);
+            }
+        }
+
+        ScopedZone(const ScopedZone&) = delete;
+        ScopedZone& operator=(const ScopedZone&) = delete;
+    };
+}
+
+// Profiling zones can be removed entirely at compile time by configuring with -DOPENLOCO_PROFILING=OFF.
+#ifdef OPENLOCO_PROFILING
+#define OPENLOCO_PROFILE_CONCAT_IMPL(a, b) a##b
+#define OPENLOCO_PROFILE_CONCAT(a, b) OPENLOCO_PROFILE_CONCAT_IMPL(a, b)
+#define OPENLOCO_PROFILE_SCOPE(name) ::OpenLoco::Diagnostics::Profiling::ScopedZone OPENLOCO_PROFILE_CONCAT(_profileZone, __LINE__)(name)
+#else
+#define OPENLOCO_PROFILE_SCOPE(name)
+#endif
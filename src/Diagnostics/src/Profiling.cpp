@@ -0,0 +1,189 @@
+#include "OpenLoco/Diagnostics/Profiling.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <fmt/format.h>
+#include <fmt/ostream.h>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace OpenLoco::Diagnostics::Profiling
+{
+    // Single writer ring buffer owned by one thread. The write index is only ever
+    // advanced by the owning thread, readers must ensure the thread is not recording.
+    struct ThreadBuffer
+    {
+        std::vector<ZoneEvent> events;
+        std::vector<ZoneStats> stats;
+        std::atomic<uint64_t> written{};
+        uint32_t threadId{};
+        uint16_t depth{};
+    };
+
+    static std::atomic<bool> _enabled{};
+    static std::mutex _buffersMutex;
+    static std::vector<std::unique_ptr<ThreadBuffer>> _buffers;
+
+    static ThreadBuffer& getThreadBuffer()
+    {
+        thread_local ThreadBuffer* buffer = nullptr;
+        if (buffer == nullptr)
+        {
+            // Buffers are never freed so zones of finished threads can still be exported.
+            auto newBuffer = std::make_unique<ThreadBuffer>();
+            newBuffer->events.resize(kZonesPerThread);
+
+            std::lock_guard<std::mutex> lock(_buffersMutex);
+            newBuffer->threadId = static_cast<uint32_t>(_buffers.size());
+            buffer = newBuffer.get();
+            _buffers.push_back(std::move(newBuffer));
+        }
+        return *buffer;
+    }
+
+    uint64_t getTimestampNs()
+    {
+        using namespace std::chrono;
+        return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+    }
+
+    void setEnabled(bool enabled)
+    {
+        _enabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    bool isEnabled()
+    {
+        return _enabled.load(std::memory_order_relaxed);
+    }
+
+    void reset()
+    {
+        std::lock_guard<std::mutex> lock(_buffersMutex);
+        for (auto& buffer : _buffers)
+        {
+            buffer->written.store(0, std::memory_order_release);
+            buffer->stats.clear();
+        }
+    }
+
+    void forEachZone(const std::function<void(const ZoneEvent&)>& callback)
+    {
+        std::lock_guard<std::mutex> lock(_buffersMutex);
+        for (auto& buffer : _buffers)
+        {
+            const auto written = buffer->written.load(std::memory_order_acquire);
+            const auto first = written > kZonesPerThread ? written - kZonesPerThread : 0;
+            for (auto i = first; i < written; i++)
+            {
+                callback(buffer->events[i % kZonesPerThread]);
+            }
+        }
+    }
+
+    void forEachZoneStats(const std::function<void(const ZoneStats&)>& callback)
+    {
+        std::vector<ZoneStats> merged;
+        {
+            std::lock_guard<std::mutex> lock(_buffersMutex);
+            for (auto& buffer : _buffers)
+            {
+                for (const auto& stats : buffer->stats)
+                {
+                    // Identical names from different translation units may not share a pointer.
+                    auto it = std::find_if(merged.begin(), merged.end(), [&stats](const ZoneStats& m) {
+                        return std::strcmp(m.name, stats.name) == 0;
+                    });
+                    if (it == merged.end())
+                    {
+                        merged.push_back(stats);
+                    }
+                    else
+                    {
+                        it->count += stats.count;
+                        it->totalNs += stats.totalNs;
+                        it->maxNs = std::max(it->maxNs, stats.maxNs);
+                    }
+                }
+            }
+        }
+
+        for (const auto& stats : merged)
+        {
+            callback(stats);
+        }
+    }
+
+    bool exportChromeTrace(const fs::path& path)
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+        {
+            return false;
+        }
+
+        // Chrome trace timestamps are in microseconds, rebase them to the first zone to keep the numbers small.
+        uint64_t baseNs = std::numeric_limits<uint64_t>::max();
+        forEachZone([&baseNs](const ZoneEvent& zone) {
+            baseNs = std::min(baseNs, zone.startNs);
+        });
+
+        fmt::print(file, "{{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+        bool first = true;
+        forEachZone([&](const ZoneEvent& zone) {
+            fmt::print(
+                file,
+                "{}\n{{\"name\":\"{}\",\"ph\":\"X\",\"pid\":1,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f},\"args\":{{\"depth\":{}}}}}",
+                first ? "" : ",",
+                zone.name,
+                zone.threadId,
+                (zone.startNs - baseNs) / 1000.0,
+                (zone.endNs - zone.startNs) / 1000.0,
+                zone.depth);
+            first = false;
+        });
+        fmt::print(file, "\n]}}\n");
+
+        return file.good();
+    }
+
+    namespace Detail
+    {
+        void enterZone()
+        {
+            getThreadBuffer().depth++;
+        }
+
+        void leaveZone(const char* name, uint64_t startNs)
+        {
+            const auto endNs = getTimestampNs();
+
+            auto& buffer = getThreadBuffer();
+            buffer.depth--;
+
+            const auto index = buffer.written.load(std::memory_order_relaxed);
+            buffer.events[index % kZonesPerThread] = ZoneEvent{ name, startNs, endNs, buffer.threadId, buffer.depth };
+            buffer.written.store(index + 1, std::memory_order_release);
+
+            // There are only a few distinct zones so a linear search on the name pointer is cheap.
+            const auto durationNs = endNs - startNs;
+            auto it = std::find_if(buffer.stats.begin(), buffer.stats.end(), [name](const ZoneStats& stats) {
+                return stats.name == name;
+            });
+            if (it == buffer.stats.end())
+            {
+                buffer.stats.push_back(ZoneStats{ name, 1, durationNs, durationNs });
+            }
+            else
+            {
+                it->count++;
+                it->totalNs += durationNs;
+                it->maxNs = std::max(it->maxNs, durationNs);
+            }
+        }
+    }
+}
@@ -0,0 +1,95 @@
+#include <OpenLoco/Diagnostics/Profiling.h>
+#include <gtest/gtest.h>
+#include <string_view>
+#include <vector>
+
+using namespace OpenLoco;
+using namespace OpenLoco::Diagnostics;
+
+static std::vector<Profiling::ZoneEvent> collectZones()
+{
+    std::vector<Profiling::ZoneEvent> zones;
+    Profiling::forEachZone([&zones](const Profiling::ZoneEvent& zone) {
+        zones.push_back(zone);
+    });
+    return zones;
+}
+
+TEST(ProfilingTests, DisabledRecordsNothing)
+{
+    Profiling::reset();
+    Profiling::setEnabled(false);
+    {
+        Profiling::ScopedZone zone("Disabled");
+    }
+    ASSERT_TRUE(collectZones().empty());
+}
+
+TEST(ProfilingTests, NestedZones)
+{
+    Profiling::reset();
+    Profiling::setEnabled(true);
+    {
+        Profiling::ScopedZone outer("Outer");
+        {
+            Profiling::ScopedZone inner("Inner");
+        }
+    }
+    Profiling::setEnabled(false);
+
+    auto zones = collectZones();
+    ASSERT_EQ(zones.size(), 2U);
+
+    // Zones are recorded when they end so the inner zone comes first.
+    ASSERT_EQ(std::string_view(zones[0].name), "Inner");
+    ASSERT_EQ(zones[0].depth, 1);
+    ASSERT_EQ(std::string_view(zones[1].name), "Outer");
+    ASSERT_EQ(zones[1].depth, 0);
+    ASSERT_LE(zones[1].startNs, zones[0].startNs);
+    ASSERT_GE(zones[1].endNs, zones[0].endNs);
+}
+
+TEST(ProfilingTests, ZoneStats)
+{
+    Profiling::reset();
+    Profiling::setEnabled(true);
+    for (auto i = 0; i < 3; i++)
+    {
+        Profiling::ScopedZone zone("Repeated");
+    }
+    {
+        Profiling::ScopedZone zone("Once");
+    }
+    Profiling::setEnabled(false);
+
+    std::vector<Profiling::ZoneStats> stats;
+    Profiling::forEachZoneStats([&stats](const Profiling::ZoneStats& s) {
+        stats.push_back(s);
+    });
+    ASSERT_EQ(stats.size(), 2U);
+    ASSERT_EQ(std::string_view(stats[0].name), "Repeated");
+    ASSERT_EQ(stats[0].count, 3U);
+    ASSERT_GE(stats[0].totalNs, stats[0].maxNs);
+    ASSERT_EQ(std::string_view(stats[1].name), "Once");
+    ASSERT_EQ(stats[1].count, 1U);
+    ASSERT_EQ(stats[1].totalNs, stats[1].maxNs);
+}
+
+TEST(ProfilingTests, RingBufferKeepsNewest)
+{
+    Profiling::reset();
+    Profiling::setEnabled(true);
+    for (uint32_t i = 0; i < Profiling::kZonesPerThread + 10; i++)
+    {
+        Profiling::ScopedZone zone(i < 10 ? "Old" : "New");
+    }
+    Profiling::setEnabled(false);
+
+    auto zones = collectZones();
+    ASSERT_EQ(zones.size(), Profiling::kZonesPerThread);
+    for (const auto& zone : zones)
+    {
+        ASSERT_EQ(std::string_view(zone.name), "New");
+    }
+    Profiling::reset();
+}
@@ -9,6 +9,7 @@
 #include "Localisation/StringIds.h"
 #include "Logging.h"
 #include "Map/SurfaceElement.h"
+#include "Map/TileChangeJournal.h"
 #include "Map/TileLoop.hpp"
 #include "Map/TileManager.h"
 #include "Map/TreeElement.h"
@@ -828,6 +829,82 @@ namespace OpenLoco::Audio
         return _volumes[zoom];
     }
 
+    struct AmbientTileCounts
+    {
+        size_t water = 0;      // bl
+        size_t wilderness = 0; // bh
+        size_t trees = 0;      // cx
+    };
+
+    static std::optional<World::TilePos2> _ambientCountsTopLeft;
+    static AmbientTileCounts _ambientCounts;
+    static uint64_t _ambientJournalCursor = 0;
+
+    static AmbientTileCounts countAmbientTiles(const World::TilePos2& topLeft, const World::TilePos2& bottomRight)
+    {
+        AmbientTileCounts counts{};
+        for (auto& tilePos : World::getClampedRange(topLeft, bottomRight))
+        {
+            const auto tile = World::TileManager::get(tilePos);
+            bool passedSurface = false;
+            for (const auto& el : tile)
+            {
+                auto* elSurface = el.as<World::SurfaceElement>();
+                if (elSurface != nullptr)
+                {
+                    passedSurface = true;
+                    if (elSurface->water() != 0)
+                    {
+                        counts.water++;
+                        break;
+                    }
+                    else if (elSurface->var_4_E0() && elSurface->isLast())
+                    {
+                        counts.wilderness++;
+                        break;
+                    }
+                    else if (elSurface->baseZ() >= 64 && elSurface->isLast())
+                    {
+                        counts.wilderness++;
+                        break;
+                    }
+                    continue;
+                }
+                auto* elTree = el.as<World::TreeElement>();
+                if (passedSurface && elTree != nullptr)
+                {
+                    const auto* treeObj = ObjectManager::get<TreeObject>(elTree->treeObjectId());
+                    if (!treeObj->hasFlags(TreeObjectFlags::droughtResistant))
+                    {
+                        counts.trees++;
+                    }
+                }
+            }
+        }
+        return counts;
+    }
+
+    // The tiles are only counted again when the view moves to another tile or the journal has a change
+    // within the search. Surfaces modified in place by original code are picked up once the view moves.
+    static const AmbientTileCounts& getAmbientTileCounts(const World::TilePos2& topLeft)
+    {
+        const auto bottomRight = topLeft + World::TilePos2{ 11, 11 };
+        bool hasChanged = _ambientCountsTopLeft != topLeft;
+        const auto hasAllChanges = World::TileChangeJournal::read(_ambientJournalCursor, [&](const World::TileChangeJournal::TileChange& change) {
+            if (change.pos.x >= topLeft.x && change.pos.x <= bottomRight.x && change.pos.y >= topLeft.y && change.pos.y <= bottomRight.y)
+            {
+                hasChanged = true;
+            }
+        });
+
+        if (hasChanged || !hasAllChanges)
+        {
+            _ambientCounts = countAmbientTiles(topLeft, bottomRight);
+            _ambientCountsTopLeft = topLeft;
+        }
+        return _ambientCounts;
+    }
+
     // 0x0048ACFD
     void updateAmbientNoise()
     {
@@ -842,61 +919,17 @@ namespace OpenLoco::Audio
         {
             maxVolume = getAmbientMaxVolume(mainViewport->zoom);
             const auto centre = mainViewport->getCentreMapPosition();
-            const auto topLeft = World::toTileSpace(centre) - World::TilePos2{ 5, 5 };
-            const auto bottomRight = topLeft + World::TilePos2{ 11, 11 };
-            const auto searchRange = World::getClampedRange(topLeft, bottomRight);
-
-            size_t waterCount = 0;      // bl
-            size_t wildernessCount = 0; // bh
-            size_t treeCount = 0;       // cx
-            for (auto& tilePos : searchRange)
-            {
-                const auto tile = World::TileManager::get(tilePos);
-                bool passedSurface = false;
-                for (const auto& el : tile)
-                {
-                    auto* elSurface = el.as<World::SurfaceElement>();
-                    if (elSurface != nullptr)
-                    {
-                        passedSurface = true;
-                        if (elSurface->water() != 0)
-                        {
-                            waterCount++;
-                            break;
-                        }
-                        else if (elSurface->var_4_E0() && elSurface->isLast())
-                        {
-                            wildernessCount++;
-                            break;
-                        }
-                        else if (elSurface->baseZ() >= 64 && elSurface->isLast())
-                        {
-                            wildernessCount++;
-                            break;
-                        }
-                        continue;
-                    }
-                    auto* elTree = el.as<World::TreeElement>();
-                    if (passedSurface && elTree != nullptr)
-                    {
-                        const auto* treeObj = ObjectManager::get<TreeObject>(elTree->treeObjectId());
-                        if (!treeObj->hasFlags(TreeObjectFlags::droughtResistant))
-                        {
-                            treeCount++;
-                        }
-                    }
-                }
-            }
+            const auto& counts = getAmbientTileCounts(World::toTileSpace(centre) - World::TilePos2{ 5, 5 });
 
-            if (waterCount > kAmbientNumWaterTilesForOcean)
+            if (counts.water > kAmbientNumWaterTilesForOcean)
             {
                 newAmbientSound = PathId::css3;
             }
-            else if (wildernessCount > kAmbientNumMountainTilesForWilderness)
+            else if (counts.wilderness > kAmbientNumMountainTilesForWilderness)
             {
                 newAmbientSound = PathId::css2;
             }
-            else if (treeCount > kAmbientNumTreeTilesForForest)
+            else if (counts.trees > kAmbientNumTreeTilesForForest)
             {
                 newAmbientSound = PathId::css4;
             }
@@ -3,10 +3,15 @@
 #include "OpenLoco.h"
 #include "S5/S5.h"
 #include "S5/SawyerStream.h"
+#include "Vehicles/Routing.h"
 #include <OpenLoco/Core/MemoryStream.h>
 #include <OpenLoco/Diagnostics/Logging.h>
+#include <OpenLoco/Diagnostics/Profiling.h>
+#include <algorithm>
 #include <chrono>
 #include <fmt/chrono.h>
+#include <fmt/ostream.h>
+#include <fstream>
 #include <iostream>
 #include <optional>
 #include <string_view>
@@ -20,6 +25,10 @@ namespace OpenLoco
 
     static int uncompressFile(const CommandLineOptions& options);
     static int simulate(const CommandLineOptions& options);
+    static int replay(const CommandLineOptions& options);
+    static int benchTiles(const CommandLineOptions& options);
+    static int benchRoutes(const CommandLineOptions& options);
+    static int benchHash(const CommandLineOptions& options);
 
     const CommandLineOptions& getCommandLineOptions()
     {
@@ -298,7 +307,11 @@ namespace OpenLoco
                           .registerOption("--help", "-h")
                           .registerOption("--version")
                           .registerOption("--intro")
-                          .registerOption("--log_levels", 1);
+                          .registerOption("--log_levels", 1)
+                          .registerOption("--trace", 1)
+                          .registerOption("--report", 1)
+                          .registerOption("--headless")
+                          .registerOption("--record", 1);
 
         if (!parser.parse())
         {
@@ -343,6 +356,26 @@ namespace OpenLoco
                 options.path = parser.getArg(1);
                 options.ticks = parser.getArg<int32_t>(2);
             }
+            else if (firstArg == "replay")
+            {
+                options.action = CommandLineAction::replay;
+                options.path = parser.getArg(1);
+            }
+            else if (firstArg == "benchtiles")
+            {
+                options.action = CommandLineAction::benchtiles;
+                options.path = parser.getArg(1);
+            }
+            else if (firstArg == "benchroutes")
+            {
+                options.action = CommandLineAction::benchroutes;
+            }
+            else if (firstArg == "benchhash")
+            {
+                options.action = CommandLineAction::benchhash;
+                options.path = parser.getArg(1);
+                options.ticks = parser.getArg<int32_t>(2);
+            }
             else
             {
                 options.path = parser.getArg(0);
@@ -360,6 +393,11 @@ namespace OpenLoco
         else
             options.logLevels = "info, warning, error";
 
+        options.tracePath = parser.getArg("--trace");
+        options.reportPath = parser.getArg("--report");
+        options.headless = parser.hasOption("--headless");
+        options.recordPath = parser.getArg("--record");
+
         return options;
     }
 
@@ -376,6 +414,10 @@ namespace OpenLoco
         std::cout << "                join [options] <address>" << std::endl;
         std::cout << "                uncompress [options] <path>" << std::endl;
         std::cout << "                simulate [options] <path> <ticks>" << std::endl;
+        std::cout << "                replay [options] <path>" << std::endl;
+        std::cout << "                benchtiles [options] <path>" << std::endl;
+        std::cout << "                benchroutes [options]" << std::endl;
+        std::cout << "                benchhash [options] <path> [iterations]" << std::endl;
         std::cout << std::endl;
         std::cout << "options:" << std::endl;
         std::cout << "--bind            Address to bind to when hosting a server" << std::endl;
@@ -389,6 +431,12 @@ namespace OpenLoco
         std::cout << "                  - info, warning, error, verbose, all" << std::endl;
         std::cout << "                  Example: --log_levels \"all, -verbose\", logs all but verbose levels" << std::endl;
         std::cout << "                  Default: \"info, warning, error\"" << std::endl;
+        std::cout << "--trace           Record profiling zones and write them as a Chrome trace to the" << std::endl;
+        std::cout << "                  given path on exit, open it with chrome://tracing or ui.perfetto.dev" << std::endl;
+        std::cout << "--report          Write a JSON benchmark report of the simulation to the given path" << std::endl;
+        std::cout << "--headless        Skip all audio and ui work while simulating" << std::endl;
+        std::cout << "--record          Record the game commands of the loaded game as a replay to the" << std::endl;
+        std::cout << "                  given path, written when the game is exited or closed" << std::endl;
     }
 
     std::optional<int> runCommandLineOnlyCommand(const CommandLineOptions& options)
@@ -405,6 +453,14 @@ namespace OpenLoco
                 return uncompressFile(options);
             case CommandLineAction::simulate:
                 return simulate(options);
+            case CommandLineAction::replay:
+                return replay(options);
+            case CommandLineAction::benchtiles:
+                return benchTiles(options);
+            case CommandLineAction::benchroutes:
+                return benchRoutes(options);
+            case CommandLineAction::benchhash:
+                return benchHash(options);
             default:
                 return {};
         }
@@ -497,6 +553,116 @@ namespace OpenLoco
         }
     }
 
+    struct SimulateReport
+    {
+        std::vector<uint64_t> tickTimesNs;
+        uint64_t simulationTimeNs{}; // Sum of all ticks
+        uint64_t wallTimeNs{};       // Including loading the file
+    };
+
+    // Returns the time in nanoseconds below which the given percentage of times fall.
+    static uint64_t getPercentileNs(const std::vector<uint64_t>& sortedTimesNs, double percentile)
+    {
+        if (sortedTimesNs.empty())
+        {
+            return 0;
+        }
+        const auto index = static_cast<size_t>(percentile / 100.0 * (sortedTimesNs.size() - 1) + 0.5);
+        return sortedTimesNs[index];
+    }
+
+    // Returns the tick time in milliseconds below which the given percentage of ticks fall.
+    static double getTickPercentileMs(const std::vector<uint64_t>& sortedTickTimesNs, double percentile)
+    {
+        return getPercentileNs(sortedTickTimesNs, percentile) / 1'000'000.0;
+    }
+
+    static void writeSimulateReport(const CommandLineOptions& options, SimulateReport& report)
+    {
+        auto& tickTimesNs = report.tickTimesNs;
+        std::sort(tickTimesNs.begin(), tickTimesNs.end());
+
+        const auto wallTimeMs = report.wallTimeNs / 1'000'000.0;
+        const auto simulationTimeMs = report.simulationTimeNs / 1'000'000.0;
+        const auto ticksPerSecond = report.simulationTimeNs != 0 ? tickTimesNs.size() * 1'000'000'000.0 / report.simulationTimeNs : 0.0;
+        const auto p50 = getTickPercentileMs(tickTimesNs, 50);
+        const auto p95 = getTickPercentileMs(tickTimesNs, 95);
+        const auto p99 = getTickPercentileMs(tickTimesNs, 99);
+        const auto max = tickTimesNs.empty() ? 0.0 : tickTimesNs.back() / 1'000'000.0;
+
+        Logging::info("Benchmark:");
+        Logging::info("  wall time:      {:.3f} ms", wallTimeMs);
+        Logging::info("  ticks time:     {:.3f} ms", simulationTimeMs);
+        Logging::info("  ticks/second:   {:.1f}", ticksPerSecond);
+        Logging::info("  tick time:      p50 {:.3f} ms, p95 {:.3f} ms, p99 {:.3f} ms, max {:.3f} ms", p50, p95, p99, max);
+
+        if (options.reportPath.empty())
+        {
+            return;
+        }
+
+        std::vector<Profiling::ZoneStats> zones;
+        Profiling::forEachZoneStats([&zones](const Profiling::ZoneStats& stats) {
+            zones.push_back(stats);
+        });
+        std::sort(zones.begin(), zones.end(), [](const Profiling::ZoneStats& a, const Profiling::ZoneStats& b) {
+            return a.totalNs > b.totalNs;
+        });
+
+        std::ofstream file(fs::u8path(options.reportPath), std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+        {
+            Logging::error("Unable to write report to {}", options.reportPath);
+            return;
+        }
+
+        const auto& gameState = getGameState();
+        fmt::print(file, "{{\n");
+        fmt::print(file, "  \"version\": \"{}\",\n", OpenLoco::getVersionInfo());
+        fmt::print(file, "  \"ticks\": {},\n", tickTimesNs.size());
+        fmt::print(file, "  \"headless\": {},\n", options.headless);
+        fmt::print(file, "  \"scenarioTicks\": {},\n", gameState.scenarioTicks);
+        fmt::print(file, "  \"rng\": [{}, {}],\n", gameState.rng.srand_0(), gameState.rng.srand_1());
+        fmt::print(file, "  \"wallTimeMs\": {:.3f},\n", wallTimeMs);
+        fmt::print(file, "  \"simulationTimeMs\": {:.3f},\n", simulationTimeMs);
+        fmt::print(file, "  \"ticksPerSecond\": {:.3f},\n", ticksPerSecond);
+        fmt::print(file, "  \"tickTimeMs\": {{ \"p50\": {:.4f}, \"p95\": {:.4f}, \"p99\": {:.4f}, \"max\": {:.4f} }},\n", p50, p95, p99, max);
+        fmt::print(file, "  \"zones\": [");
+        for (size_t i = 0; i < zones.size(); i++)
+        {
+            const auto& zone = zones[i];
+            fmt::print(
+                file,
+                "{}\n    {{ \"name\": \"{}\", \"count\": {}, \"totalMs\": {:.4f}, \"meanMs\": {:.4f}, \"maxMs\": {:.4f} }}",
+                i == 0 ? "" : ",",
+                zone.name,
+                zone.count,
+                zone.totalNs / 1'000'000.0,
+                zone.totalNs / 1'000'000.0 / zone.count,
+                zone.maxNs / 1'000'000.0);
+        }
+        fmt::print(file, "\n  ]\n}}\n");
+
+        Logging::info("  report:         {}", options.reportPath);
+    }
+
+    static void writeTrace(const CommandLineOptions& options)
+    {
+        if (options.tracePath.empty())
+        {
+            return;
+        }
+
+        if (Profiling::exportChromeTrace(fs::u8path(options.tracePath)))
+        {
+            Logging::info("  trace:          {}", options.tracePath);
+        }
+        else
+        {
+            Logging::error("Unable to write trace to {}", options.tracePath);
+        }
+    }
+
     static int simulate(const CommandLineOptions& options)
     {
         if (!options.ticks)
@@ -510,14 +676,23 @@ namespace OpenLoco
 
         const auto timeStarted = std::chrono::high_resolution_clock::now();
 
+        SimulateReport report;
+        report.tickTimesNs.reserve(std::max(*options.ticks, 0));
+
+        // The report needs the zone statistics for its per manager breakdown.
+        Profiling::setEnabled(!options.tracePath.empty() || !options.reportPath.empty());
         try
         {
-            OpenLoco::simulateGame(inPath, *options.ticks);
+            OpenLoco::simulateGame(inPath, *options.ticks, options.headless, [&report](uint64_t tickTimeNs) {
+                report.tickTimesNs.push_back(tickTimeNs);
+                report.simulationTimeNs += tickTimeNs;
+            });
         }
         catch (...)
         {
             Logging::error("Unable to load and simulate {}", inPath.u8string());
         }
+        Profiling::setEnabled(false);
 
         const auto timeElapsed = std::chrono::high_resolution_clock::now() - timeStarted;
 
@@ -533,6 +708,11 @@ namespace OpenLoco
         Logging::info("  rng:            {{ {}, {} }}", gameState.rng.srand_0(), gameState.rng.srand_1());
         Logging::info("Duration: {:%S} sec", timeElapsed);
 
+        report.wallTimeNs = std::chrono::duration_cast<std::chrono::nanoseconds>(timeElapsed).count();
+        writeSimulateReport(options, report);
+
+        writeTrace(options);
+
         if (!outPath.empty())
         {
             try
@@ -548,4 +728,152 @@ namespace OpenLoco
 
         return 0;
     }
+
+    static int replay(const CommandLineOptions& options)
+    {
+        auto inPath = fs::u8path(options.path);
+
+        const auto timeStarted = std::chrono::high_resolution_clock::now();
+
+        SimulateReport report;
+
+        Profiling::setEnabled(!options.tracePath.empty() || !options.reportPath.empty());
+        std::optional<uint32_t> numMismatches;
+        try
+        {
+            numMismatches = OpenLoco::replayGame(inPath, options.headless, [&report](uint64_t tickTimeNs) {
+                report.tickTimesNs.push_back(tickTimeNs);
+                report.simulationTimeNs += tickTimeNs;
+            });
+        }
+        catch (...)
+        {
+            Logging::error("Unable to load and replay {}", inPath.u8string());
+        }
+        Profiling::setEnabled(false);
+
+        const auto timeElapsed = std::chrono::high_resolution_clock::now() - timeStarted;
+
+        auto& gameState = getGameState();
+        Logging::info("--------------------------------");
+        Logging::info("- Replay");
+        Logging::info("--------------------------------");
+        Logging::info("Input:");
+        Logging::info("  path: {}", inPath.u8string());
+        Logging::info("Output:");
+        Logging::info("  scenario ticks: {}", gameState.scenarioTicks);
+        Logging::info("  rng:            {{ {}, {} }}", gameState.rng.srand_0(), gameState.rng.srand_1());
+        Logging::info("Duration: {:%S} sec", timeElapsed);
+
+        report.wallTimeNs = std::chrono::duration_cast<std::chrono::nanoseconds>(timeElapsed).count();
+        writeSimulateReport(options, report);
+        writeTrace(options);
+
+        if (!numMismatches)
+        {
+            return 2;
+        }
+        return *numMismatches == 0 ? 0 : 3;
+    }
+
+    static void logOperationTimes(const char* name, std::vector<uint64_t>& timesNs)
+    {
+        std::sort(timesNs.begin(), timesNs.end());
+        uint64_t totalNs = 0;
+        for (const auto timeNs : timesNs)
+        {
+            totalNs += timeNs;
+        }
+        Logging::info(
+            "  {}: {} in {:.3f} ms, p50 {:.3f} us, p99 {:.3f} us, max {:.3f} us",
+            name,
+            timesNs.size(),
+            totalNs / 1'000'000.0,
+            getPercentileNs(timesNs, 50) / 1'000.0,
+            getPercentileNs(timesNs, 99) / 1'000.0,
+            timesNs.empty() ? 0.0 : timesNs.back() / 1'000.0);
+    }
+
+    static int benchTiles(const CommandLineOptions& options)
+    {
+        auto inPath = fs::u8path(options.path);
+
+        std::vector<uint64_t> insertTimesNs;
+        std::vector<uint64_t> removeTimesNs;
+        try
+        {
+            OpenLoco::benchmarkTileElements(
+                inPath,
+                options.headless,
+                [&insertTimesNs](uint64_t timeNs) { insertTimesNs.push_back(timeNs); },
+                [&removeTimesNs](uint64_t timeNs) { removeTimesNs.push_back(timeNs); });
+        }
+        catch (...)
+        {
+            Logging::error("Unable to load and benchmark {}", inPath.u8string());
+            return 2;
+        }
+
+        Logging::info("--------------------------------");
+        Logging::info("- Tile element benchmark");
+        Logging::info("--------------------------------");
+        Logging::info("Input:");
+        Logging::info("  path: {}", inPath.u8string());
+        Logging::info("Benchmark:");
+        logOperationTimes("inserts", insertTimesNs);
+        logOperationTimes("removes", removeTimesNs);
+        return 0;
+    }
+
+    static int benchRoutes([[maybe_unused]] const CommandLineOptions& options)
+    {
+        Logging::info("--------------------------------");
+        Logging::info("- Location of interest map benchmark");
+        Logging::info("--------------------------------");
+        for (const size_t numLocations : { 1'000, 10'000, 100'000 })
+        {
+            const auto result = Vehicles::benchmarkLocationOfInterestMap(numLocations);
+            if (result.numFound != numLocations)
+            {
+                Logging::error("Only {} of {} locations were found again", result.numFound, numLocations);
+                return 2;
+            }
+            Logging::info(
+                "  {} locations: insert {:.1f} ns, lookup {:.1f} ns",
+                numLocations,
+                static_cast<double>(result.insertNs) / numLocations,
+                static_cast<double>(result.lookupNs) / numLocations);
+        }
+        return 0;
+    }
+
+    static int benchHash(const CommandLineOptions& options)
+    {
+        auto inPath = fs::u8path(options.path);
+        const auto iterations = options.ticks.value_or(100);
+
+        std::vector<uint64_t> hashTimesNs;
+        try
+        {
+            OpenLoco::benchmarkStateHash(
+                inPath,
+                options.headless,
+                iterations,
+                [&hashTimesNs](uint64_t timeNs) { hashTimesNs.push_back(timeNs); });
+        }
+        catch (...)
+        {
+            Logging::error("Unable to load and benchmark {}", inPath.u8string());
+            return 2;
+        }
+
+        Logging::info("--------------------------------");
+        Logging::info("- State hash benchmark");
+        Logging::info("--------------------------------");
+        Logging::info("Input:");
+        Logging::info("  path: {}", inPath.u8string());
+        Logging::info("Benchmark:");
+        logOperationTimes("hashes", hashTimesNs);
+        return hashTimesNs.size() == static_cast<size_t>(iterations) ? 0 : 2;
+    }
 }
@@ -14,6 +14,10 @@ namespace OpenLoco
         join,
         uncompress,
         simulate,
+        replay,
+        benchtiles,
+        benchroutes,
+        benchhash,
         help,
         version,
         intro,
@@ -29,6 +33,10 @@ namespace OpenLoco
         std::string bind;
         std::optional<uint16_t> port{};
         std::string logLevels;
+        std::string tracePath;
+        std::string reportPath;
+        bool headless{};
+        std::string recordPath;
     };
 
     std::optional<CommandLineOptions> parseCommandLine(std::vector<std::string>&& argv);
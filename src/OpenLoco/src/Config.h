@@ -190,6 +190,7 @@ namespace OpenLoco::Config
         bool buildLockedVehicles = false;
         bool invertRightMouseViewPan = false;
         bool cashPopupRendering = true;
+        int32_t miscEntityLimit = 4000;
         bool allowMultipleInstances = false;
         LocoConfig old;
 
@@ -1,4 +1,5 @@
 #include "EntityManager.h"
+#include "Config.h"
 #include "EntityTweener.h"
 #include "GameCommands/GameCommands.h"
 #include "GameState.h"
@@ -7,6 +8,8 @@
 #include "Logging.h"
 #include <OpenLoco/Core/LocoFixedVector.hpp>
 #include <OpenLoco/Interop/Interop.hpp>
+#include <algorithm>
+#include <array>
 
 using namespace OpenLoco::Interop;
 using namespace OpenLoco::Diagnostics;
@@ -22,6 +25,19 @@ namespace OpenLoco::EntityManager
     loco_global<EntityId[kSpatialEntityMapSize], 0x01025A8C> _entitySpatialIndex;
     loco_global<uint32_t, 0x01025A88> _entitySpatialCount;
 
+    // Previous entity of each entity in its quadrant list, the original only links forwards through
+    // nextQuadrantId. Original code can still modify the lists without updating these so they are
+    // only used as a hint that is verified before use.
+    static std::array<EntityId, Limits::kMaxEntities> _previousQuadrantIds;
+
+    // Misc entities share the normal pool with vehicles, enough of it is held back for every vehicle to have
+    // its head, two vehicle and tail entities and the two bogies and body of one car.
+    constexpr size_t kVehicleEntityReserve = Limits::kMaxVehicles * 7;
+    constexpr size_t kMaxMiscEntityLimit = Limits::maxNormalEntities - kVehicleEntityReserve;
+    static_assert(kMaxMiscEntityLimit >= Limits::kMaxMiscEntities);
+
+    static uint16_t _maxMiscEntities = Limits::kMaxMiscEntities;
+
     static auto& rawEntities() { return getGameState().entities; }
     static auto entities() { return FixedVector(rawEntities()); }
     static auto& rawListHeads() { return getGameState().entityListHeads; }
@@ -40,6 +56,9 @@ namespace OpenLoco::EntityManager
     // 0x0046FDFD
     void reset()
     {
+        // A reset starts a new game which takes the limit from the config, loading a save restores its own.
+        setMiscEntityLimit(std::max<int32_t>(Config::get().miscEntityLimit, 0));
+
         // Reset all entities to 0
         std::fill(std::begin(rawEntities()), std::end(rawEntities()), Entity{});
         // Reset all entity lists
@@ -140,7 +159,13 @@ namespace OpenLoco::EntityManager
 
     static void insertToSpatialIndex(EntityBase& entity, const size_t newIndex)
     {
-        entity.nextQuadrantId = _entitySpatialIndex[newIndex];
+        const auto nextId = _entitySpatialIndex[newIndex];
+        if (enumValue(nextId) < Limits::kMaxEntities)
+        {
+            _previousQuadrantIds[enumValue(nextId)] = entity.id;
+        }
+        _previousQuadrantIds[enumValue(entity.id)] = EntityId::null;
+        entity.nextQuadrantId = nextId;
         _entitySpatialIndex[newIndex] = entity.id;
     }
 
@@ -155,6 +180,7 @@ namespace OpenLoco::EntityManager
     {
         // Clear existing array
         std::fill(std::begin(_entitySpatialIndex), std::end(_entitySpatialIndex), EntityId::null);
+        std::fill(std::begin(_previousQuadrantIds), std::end(_previousQuadrantIds), EntityId::null);
 
         // Original filled an unreferenced array at 0x010A5A8E as well then overwrote part of it???
 
@@ -174,8 +200,45 @@ namespace OpenLoco::EntityManager
         }
     }
 
+    // Returns the link pointing at the entity if the previous entity hint is still valid.
+    static EntityId* getQuadrantLinkFromHint(const EntityBase& entity, const size_t index)
+    {
+        const auto previousId = _previousQuadrantIds[enumValue(entity.id)];
+        if (previousId == EntityId::null)
+        {
+            return _entitySpatialIndex[index] == entity.id ? &_entitySpatialIndex[index] : nullptr;
+        }
+
+        // Removed entities keep their nextQuadrantId so the previous entity must also still be in the list.
+        auto* previous = get<EntityBase>(previousId);
+        if (previous == nullptr || previous->nextQuadrantId != entity.id || previous->empty() || getSpatialIndexOffset(previous->position) != index)
+        {
+            return nullptr;
+        }
+        return &previous->nextQuadrantId;
+    }
+
+    static void unlinkFromSpatialIndex(EntityBase& entity, EntityId* link)
+    {
+        const auto nextId = entity.nextQuadrantId;
+        if (enumValue(nextId) < Limits::kMaxEntities)
+        {
+            _previousQuadrantIds[enumValue(nextId)] = _previousQuadrantIds[enumValue(entity.id)];
+        }
+        *link = nextId;
+    }
+
     static bool removeFromSpatialIndex(EntityBase& entity, const size_t index)
     {
+        auto* link = getQuadrantLinkFromHint(entity, index);
+        if (link != nullptr)
+        {
+            unlinkFromSpatialIndex(entity, link);
+            return true;
+        }
+
+        // The list was modified by original code, find the entity the slow way.
+        EntityId previousId = EntityId::null;
         auto* quadId = &_entitySpatialIndex[index];
         _entitySpatialCount = 0;
         while (enumValue(*quadId) < Limits::kMaxEntities)
@@ -183,7 +246,8 @@ namespace OpenLoco::EntityManager
             auto* quadEnt = get<EntityBase>(*quadId);
             if (quadEnt == &entity)
             {
-                *quadId = entity.nextQuadrantId;
+                _previousQuadrantIds[enumValue(entity.id)] = previousId;
+                unlinkFromSpatialIndex(entity, quadId);
                 return true;
             }
             _entitySpatialCount++;
@@ -191,6 +255,7 @@ namespace OpenLoco::EntityManager
             {
                 break;
             }
+            previousId = quadEnt->id;
             quadId = &quadEnt->nextQuadrantId;
         }
         return false;
@@ -220,6 +285,52 @@ namespace OpenLoco::EntityManager
         entity.position = loc;
     }
 
+    std::vector<EntityId>& getRangeQueryIds()
+    {
+        static std::vector<EntityId> _rangeQueryIds;
+        return _rangeQueryIds;
+    }
+
+    template<typename TPred>
+    static void collectEntitiesInRect(const World::Pos2& min, const World::Pos2& max, std::vector<EntityId>& ids, TPred&& pred)
+    {
+        constexpr coord_t kMaxCoord = World::kMapPitch * World::kTileSize - 1;
+        const auto minTile = World::toTileSpace(World::Pos2(std::max<coord_t>(min.x, 0), std::max<coord_t>(min.y, 0)));
+        const auto maxTile = World::toTileSpace(World::Pos2(std::min<coord_t>(max.x, kMaxCoord), std::min<coord_t>(max.y, kMaxCoord)));
+
+        // Same order as the spatial index so neighbouring tiles are read from neighbouring memory.
+        for (auto tileX = minTile.x; tileX <= maxTile.x; tileX++)
+        {
+            for (auto tileY = minTile.y; tileY <= maxTile.y; tileY++)
+            {
+                for (auto* entity : EntityTileList(World::toWorldSpace(World::TilePos2(tileX, tileY))))
+                {
+                    const auto& pos = entity->position;
+                    if (pos.x >= min.x && pos.x <= max.x && pos.y >= min.y && pos.y <= max.y && pred(*entity))
+                    {
+                        ids.push_back(entity->id);
+                    }
+                }
+            }
+        }
+    }
+
+    void collectEntitiesInRect(const World::Pos2& min, const World::Pos2& max, std::vector<EntityId>& ids)
+    {
+        collectEntitiesInRect(min, max, ids, [](const EntityBase&) { return true; });
+    }
+
+    void collectEntitiesInRadius(const World::Pos2& centre, coord_t radius, std::vector<EntityId>& ids)
+    {
+        const auto radiusSquared = static_cast<int32_t>(radius) * radius;
+        const auto extent = World::Pos2(radius, radius);
+        collectEntitiesInRect(centre - extent, centre + extent, ids, [&centre, radiusSquared](const EntityBase& entity) {
+            const auto dx = static_cast<int32_t>(entity.position.x) - centre.x;
+            const auto dy = static_cast<int32_t>(entity.position.y) - centre.y;
+            return dx * dx + dy * dy <= radiusSquared;
+        });
+    }
+
     static EntityBase* createEntity(EntityId id, EntityListType list)
     {
         auto* newEntity = get<EntityBase>(id);
@@ -243,10 +354,20 @@ namespace OpenLoco::EntityManager
         return newEntity;
     }
 
+    void setMiscEntityLimit(size_t limit)
+    {
+        _maxMiscEntities = static_cast<uint16_t>(std::clamp(limit, Limits::kMaxMiscEntities, kMaxMiscEntityLimit));
+    }
+
+    uint16_t getMiscEntityLimit()
+    {
+        return _maxMiscEntities;
+    }
+
     // 0x004700A5
     EntityBase* createEntityMisc()
     {
-        if (getListCount(EntityListType::misc) >= Limits::kMaxMiscEntities)
+        if (getListCount(EntityListType::misc) >= _maxMiscEntities)
         {
             return nullptr;
         }
@@ -4,6 +4,7 @@
 #include <OpenLoco/Engine/World.hpp>
 #include <cstdio>
 #include <iterator>
+#include <vector>
 
 namespace OpenLoco::Vehicles
 {
@@ -43,6 +44,51 @@ namespace OpenLoco::EntityManager
     void updateSpatialIndex();
     void moveSpatialEntry(EntityBase& entity, const World::Pos3& loc);
 
+    // Appends the ids of the entities positioned within the inclusive rectangle or the radius (ignoring height).
+    void collectEntitiesInRect(const World::Pos2& min, const World::Pos2& max, std::vector<EntityId>& ids);
+    void collectEntitiesInRadius(const World::Pos2& centre, coord_t radius, std::vector<EntityId>& ids);
+    // Scratch ids of the range queries below, used as a stack so a callback can run a query of its own.
+    std::vector<EntityId>& getRangeQueryIds();
+
+    // Invokes the callback for every entity collected by the query. All ids are collected before the first
+    // callback so the callback may move or free entities: an entity moved between tiles is not visited twice
+    // and entities freed by an earlier callback are skipped.
+    template<typename TCollect, typename TFunc>
+    void forEachCollectedEntity(TCollect&& collect, TFunc&& func)
+    {
+        auto& ids = getRangeQueryIds();
+        const auto start = ids.size();
+        collect(ids);
+        const auto end = ids.size();
+        for (auto i = start; i < end; i++)
+        {
+            auto* entity = get<EntityBase>(ids[i]);
+            if (entity != nullptr && entity->baseType != EntityBaseType::null)
+            {
+                func(*entity);
+            }
+        }
+        ids.resize(start);
+    }
+
+    template<typename TFunc>
+    void forEachEntityInRect(const World::Pos2& min, const World::Pos2& max, TFunc&& func)
+    {
+        forEachCollectedEntity([&](std::vector<EntityId>& ids) { collectEntitiesInRect(min, max, ids); }, func);
+    }
+
+    template<typename TFunc>
+    void forEachEntityInRadius(const World::Pos2& centre, coord_t radius, TFunc&& func)
+    {
+        forEachCollectedEntity([&](std::vector<EntityId>& ids) { collectEntitiesInRadius(centre, radius, ids); }, func);
+    }
+
+    // The misc pool shares the normal entity storage so it can be raised until only a reserve for vehicles
+    // is left, the limit is stored in saves that use a non default value. Only spawners implemented in
+    // OpenLoco honour it, original code calling 0x004700A5 keeps the default limit.
+    void setMiscEntityLimit(size_t limit);
+    uint16_t getMiscEntityLimit();
+
     EntityBase* createEntityMisc();
     EntityBase* createEntityMoney();
     EntityBase* createEntityVehicle();
@@ -11,39 +11,62 @@ namespace OpenLoco
     using EntityListIterator = EntityManager::ListIterator<EntityBase, &EntityBase::nextThingId>;
 
     template<EntityListType id, typename Pred>
-    void PopulateEntities(std::vector<EntityBase*>& list, std::vector<World::Pos3>& posList, const Pred& pred)
+    static void forEachEntity(const Pred& pred)
     {
         auto entsView = EntityManager::EntityList<EntityListIterator, id>();
         for (auto* ent : entsView)
         {
-            if (!pred(ent))
-                continue;
-
-            list.push_back(ent);
-            posList.emplace_back(ent->position);
+            pred(ent);
         }
     }
 
     static EntityTweener _tweener;
 
+    EntityTweener::EntityTweener()
+    {
+        _slotById.fill(kNoSlot);
+    }
+
     EntityTweener& EntityTweener::get()
     {
         return _tweener;
     }
 
+    void EntityTweener::addEntity(EntityBase* entity)
+    {
+        _slotById[enumValue(entity->id)] = static_cast<uint16_t>(_entities.size());
+        _entities.push_back(entity);
+        _preX.push_back(entity->position.x);
+        _preY.push_back(entity->position.y);
+        _preZ.push_back(entity->position.z);
+    }
+
     void EntityTweener::preTick()
     {
         restore();
         reset();
-        PopulateEntities<EntityListType::misc>(_entities, _prePos, [](auto*) { return true; });
-        PopulateEntities<EntityListType::vehicle>(_entities, _prePos, [](auto* ent) {
-            const auto* vehicle = ent->template asBase<Vehicles::VehicleBase>();
+
+        if (_entities.capacity() < Limits::kMaxEntities)
+        {
+            for (auto* buffer : { &_preX, &_preY, &_preZ, &_postX, &_postY, &_postZ, &_tweenX, &_tweenY, &_tweenZ })
+            {
+                buffer->reserve(Limits::kMaxEntities);
+            }
+            _entities.reserve(Limits::kMaxEntities);
+        }
+
+        forEachEntity<EntityListType::misc>([this](EntityBase* ent) { addEntity(ent); });
+        forEachEntity<EntityListType::vehicle>([this](EntityBase* ent) {
+            const auto* vehicle = ent->asBase<Vehicles::VehicleBase>();
             if (vehicle == nullptr)
             {
                 // This can be never null but makes the compiler happy.
-                return false;
+                return;
+            }
+            if (vehicle->isVehicleBody() || vehicle->isVehicleBogie())
+            {
+                addEntity(ent);
             }
-            return vehicle->isVehicleBody() || vehicle->isVehicleBogie();
         });
     }
 
@@ -54,27 +77,57 @@ namespace OpenLoco
             if (ent == nullptr || ent->id == EntityId::null)
             {
                 // Sprite was removed, add a dummy position to keep the index aligned.
-                _postPos.emplace_back(0, 0, 0);
+                _postX.push_back(0);
+                _postY.push_back(0);
+                _postZ.push_back(0);
             }
             else
             {
-                _postPos.emplace_back(ent->position);
+                _postX.push_back(ent->position.x);
+                _postY.push_back(ent->position.y);
+                _postZ.push_back(ent->position.z);
             }
         }
     }
 
     void EntityTweener::removeEntity(const EntityBase* entity)
     {
-        auto it = std::find(_entities.begin(), _entities.end(), entity);
-        if (it != _entities.end())
+        auto& slot = _slotById[enumValue(entity->id)];
+        if (slot == kNoSlot)
         {
-            *it = nullptr;
+            return;
         }
+        _entities[slot] = nullptr;
+        slot = kNoSlot;
     }
 
-    void EntityTweener::tween(float alpha)
+    // Interpolates every axis in one pass over contiguous arrays so the compiler can vectorise it.
+    static void interpolate(const std::vector<float>& pre, const std::vector<float>& post, std::vector<float>& result, float alpha)
     {
         const float inv = (1.0f - alpha);
+        const auto count = pre.size();
+        result.resize(count);
+
+        const float* a = pre.data();
+        const float* b = post.data();
+        float* out = result.data();
+        for (size_t i = 0; i < count; ++i)
+        {
+            out[i] = std::round(b[i] * alpha + a[i] * inv);
+        }
+    }
+
+    void EntityTweener::tween(float alpha)
+    {
+        // postTick has not run when no tick happened since the last reset.
+        if (_postX.size() != _entities.size())
+        {
+            return;
+        }
+
+        interpolate(_preX, _postX, _tweenX, alpha);
+        interpolate(_preY, _postY, _tweenY, alpha);
+        interpolate(_preZ, _postZ, _tweenZ, alpha);
 
         for (size_t i = 0; i < _entities.size(); ++i)
         {
@@ -82,15 +135,12 @@ namespace OpenLoco
             if (ent == nullptr)
                 continue;
 
-            auto& posA = _prePos[i];
-            auto& posB = _postPos[i];
-
-            if (posA == posB)
+            if (_preX[i] == _postX[i] && _preY[i] == _postY[i] && _preZ[i] == _postZ[i])
                 continue;
 
-            auto newPos = World::Pos3{ static_cast<int16_t>(std::round(posB.x * alpha + posA.x * inv)),
-                                       static_cast<int16_t>(std::round(posB.y * alpha + posA.y * inv)),
-                                       static_cast<int16_t>(std::round(posB.z * alpha + posA.z * inv)) };
+            auto newPos = World::Pos3{ static_cast<int16_t>(_tweenX[i]),
+                                       static_cast<int16_t>(_tweenY[i]),
+                                       static_cast<int16_t>(_tweenZ[i]) };
 
             if (ent->position == newPos)
                 continue;
@@ -102,13 +152,20 @@ namespace OpenLoco
 
     void EntityTweener::restore()
     {
+        if (_postX.size() != _entities.size())
+        {
+            return;
+        }
+
         for (size_t i = 0; i < _entities.size(); ++i)
         {
             auto* ent = _entities[i];
             if (ent == nullptr)
                 continue;
 
-            auto& newPos = _postPos[i];
+            auto newPos = World::Pos3{ static_cast<int16_t>(_postX[i]),
+                                       static_cast<int16_t>(_postY[i]),
+                                       static_cast<int16_t>(_postZ[i]) };
 
             if (ent->position == newPos)
                 continue;
@@ -120,9 +177,20 @@ namespace OpenLoco
 
     void EntityTweener::reset()
     {
+        for (auto* ent : _entities)
+        {
+            if (ent != nullptr)
+            {
+                _slotById[enumValue(ent->id)] = kNoSlot;
+            }
+        }
         _entities.clear();
-        _prePos.clear();
-        _postPos.clear();
+        _preX.clear();
+        _preY.clear();
+        _preZ.clear();
+        _postX.clear();
+        _postY.clear();
+        _postZ.clear();
     }
 
 }
@@ -1,18 +1,30 @@
 #pragma once
 
 #include "EntityManager.h"
+#include "Engine/Limits.h"
 #include <OpenLoco/Engine/World.hpp>
+#include <array>
 #include <vector>
 
 namespace OpenLoco
 {
     class EntityTweener
     {
+        static constexpr uint16_t kNoSlot = 0xFFFF;
+
+        // Buffers keep their capacity between ticks, positions are stored per axis so they can be
+        // interpolated in batches.
         std::vector<EntityBase*> _entities;
-        std::vector<World::Pos3> _prePos;
-        std::vector<World::Pos3> _postPos;
+        std::vector<float> _preX, _preY, _preZ;
+        std::vector<float> _postX, _postY, _postZ;
+        std::vector<float> _tweenX, _tweenY, _tweenZ;
+        std::array<uint16_t, Limits::kMaxEntities> _slotById;
+
+        void addEntity(EntityBase* entity);
 
     public:
+        EntityTweener();
+
         static EntityTweener& get();
 
         void preTick();
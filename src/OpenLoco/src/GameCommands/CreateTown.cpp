@@ -30,6 +30,7 @@ namespace OpenLoco::GameCommands
         regs.eax = pos.x;
         regs.ecx = pos.y;
         call(0x00496FE7, regs);
+        TownManager::invalidateOccupancy();
 
         if (regs.esi != -1)
             return reinterpret_cast<Town*>(regs.esi);
@@ -162,6 +163,7 @@ namespace OpenLoco::GameCommands
         {
             StringManager::emptyUserString(newTown->name);
             newTown->name = StringIds::null;
+            TownManager::invalidateOccupancy();
             return 0;
         }
 
@@ -5,17 +5,21 @@
 #include "Map/RoadElement.h"
 #include "Map/StationElement.h"
 #include "Map/Tile.h"
+#include "Map/Track/Track.h"
 #include "Map/TrackElement.h"
 #include "Network/Network.h"
 #include "Objects/ObjectManager.h"
 #include "Objects/RoadObject.h"
 #include "Objects/TrackObject.h"
+#include "Replay.h"
 #include "SceneManager.h"
 #include "Ui/WindowManager.h"
 #include "Vehicles/Vehicle.h"
 #include "World/Company.h"
 #include "World/CompanyManager.h"
+#include "World/IndustryManager.h"
 #include "World/StationManager.h"
+#include "World/TownManager.h"
 #include <cassert>
 
 using namespace OpenLoco::Ui;
@@ -203,6 +207,13 @@ namespace OpenLoco::GameCommands
             return loc_4313C6(esi, copyRegs);
         }
 
+        if (!isGhost && Replay::isRecording())
+        {
+            registers copyRegs = regs;
+            copyRegs.esi = static_cast<int32_t>(command);
+            Replay::recordGameCommand(_updatingCompanyId, copyRegs);
+        }
+
         return doCommandForReal(command, _updatingCompanyId, regs);
     }
 
@@ -260,6 +271,19 @@ namespace OpenLoco::GameCommands
         }
     }
 
+    // Any command may have built or removed stations, industries, towns, vehicles, track or road. Only called
+    // once the outermost command has been applied. Ghost commands are skipped as construction places and removes
+    // them on every mouse move, the caches either ignore ghosts or at worst lag until the next real command.
+    static void invalidateCaches()
+    {
+        StationManager::invalidateCoverage();
+        StationManager::invalidateOccupancy();
+        IndustryManager::invalidateOccupancy();
+        TownManager::invalidateOccupancy();
+        Vehicles::invalidateSignalBlocks();
+        World::Track::invalidateConnections();
+    }
+
     static uint32_t loc_4313C6(int esi, const registers& regs)
     {
         uint16_t flags = regs.bx;
@@ -317,6 +341,12 @@ namespace OpenLoco::GameCommands
         int32_t ebx2 = fnRegs2.ebx;
         _gameCommandFlags = flagsBackup2;
 
+        // Also when applying failed as it may have got part of the way.
+        if (_gameCommandNestLevel == 1 && (flags & Flags::ghost) == 0)
+        {
+            invalidateCaches();
+        }
+
         if (ebx2 == static_cast<int32_t>(GameCommands::FAILURE))
         {
             return loc_4314EA();
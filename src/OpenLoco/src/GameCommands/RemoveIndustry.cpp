@@ -22,7 +22,7 @@ namespace OpenLoco::GameCommands
     static void removeElement(const World::Pos2& pos, World::TileElement& el)
     {
         Ui::ViewportManager::invalidate(pos, el.baseHeight(), el.clearHeight());
-        World::TileManager::removeElement(el);
+        World::TileManager::removeElement(el, pos);
     }
 
     // 0x0045579F
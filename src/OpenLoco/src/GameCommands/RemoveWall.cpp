@@ -53,7 +53,7 @@ namespace OpenLoco::GameCommands
 
             Ui::ViewportManager::invalidate(args.pos, wallElement->baseHeight(), wallElement->baseHeight() + 48, ZoomLevel::half);
 
-            TileManager::removeElement(tileElement);
+            TileManager::removeElement(tileElement, args.pos);
 
             auto& options = S5::getOptions();
             options.madeAnyChanges = 1;
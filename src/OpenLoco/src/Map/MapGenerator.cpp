@@ -10,6 +10,7 @@
 #include "Scenario.h"
 #include "SurfaceElement.h"
 #include "Tile.h"
+#include "TileChangeJournal.h"
 #include "TileLoop.hpp"
 #include "TileManager.h"
 #include "Tree.h"
@@ -697,7 +698,7 @@ namespace OpenLoco::World::MapGenerator
             // Remove in reverse order to prevent pointer invalidation
             for (auto elIter = std::rbegin(toBeRemoved); elIter != std::rend(toBeRemoved); ++elIter)
             {
-                TileManager::removeElement(**elIter);
+                TileManager::removeElement(**elIter, toWorldSpace(loc));
             }
             toBeRemoved.clear();
         }
@@ -797,6 +798,9 @@ namespace OpenLoco::World::MapGenerator
 
         call(0x004969E0);
         Scenario::sub_4748D4();
+
+        // The surfaces were shaped in place without being recorded
+        TileChangeJournal::reset();
         Ui::ProgressBar::end();
     }
 }
@@ -93,13 +93,7 @@ namespace OpenLoco::World
 
     SurfaceElement* Tile::surface() const
     {
-        for (auto& tile : *this)
-        {
-            auto* result = tile.as<SurfaceElement>();
-            if (result != nullptr)
-                return result;
-        }
-        return nullptr;
+        return first<SurfaceElement>();
     }
 
     StationElement* Tile::trackStation(uint8_t trackId, uint8_t direction, uint8_t baseZ) const
@@ -6,6 +6,7 @@
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <iterator>
 #include <limits>
 #include <tuple>
 
@@ -43,6 +44,79 @@ namespace OpenLoco::World
     struct SurfaceElement;
     struct StationElement;
 
+    // Visits only the elements of one type, the end of the tile is found while iterating rather than up
+    // front so loops that exit early only touch the elements before the one they were looking for.
+    template<typename TType>
+    class TileElementsOfType
+    {
+    private:
+        TileElement* const _first;
+
+        class Iterator
+        {
+        private:
+            TileElement* _el;
+
+            constexpr void findNext()
+            {
+                while (_el != nullptr && _el->type() != TType::kElementType)
+                {
+                    _el = _el->isLast() ? nullptr : _el + 1;
+                }
+            }
+
+        public:
+            constexpr Iterator(TileElement* el)
+                : _el(el)
+            {
+                findNext();
+            }
+
+            constexpr Iterator& operator++()
+            {
+                _el = _el->isLast() ? nullptr : _el + 1;
+                findNext();
+                return *this;
+            }
+
+            constexpr Iterator operator++(int)
+            {
+                Iterator retval = *this;
+                ++(*this);
+                return retval;
+            }
+
+            constexpr bool operator==(Iterator other) const
+            {
+                return _el == other._el;
+            }
+            constexpr bool operator!=(Iterator other) const
+            {
+                return !(*this == other);
+            }
+
+            TType& operator*() const
+            {
+                return _el->get<TType>();
+            }
+            // iterator traits
+            using difference_type = std::ptrdiff_t;
+            using value_type = TType;
+            using pointer = TType*;
+            using reference = TType&;
+            using iterator_category = std::forward_iterator_tag;
+        };
+
+    public:
+        constexpr TileElementsOfType(TileElement* first)
+            : _first(first)
+        {
+        }
+
+        Iterator begin() const { return Iterator(_first); }
+        Iterator end() const { return Iterator(nullptr); }
+    };
+
     struct Tile
     {
     private:
@@ -62,6 +136,27 @@ namespace OpenLoco::World
         size_t size();
         TileElement* operator[](size_t i);
 
+        template<typename TType>
+        TileElementsOfType<TType> elementsOfType() const
+        {
+            return TileElementsOfType<TType>(_data);
+        }
+
+        // Returns the first element of the given type, stops at it rather than walking the whole tile.
+        template<typename TType>
+        TType* first() const
+        {
+            auto elements = elementsOfType<TType>();
+            auto it = elements.begin();
+            return it != elements.end() ? &*it : nullptr;
+        }
+
+        template<typename TType>
+        bool has() const
+        {
+            return first<TType>() != nullptr;
+        }
+
         size_t indexOf(const TileElementBase* element) const;
         SurfaceElement* surface() const;
         StationElement* trackStation(uint8_t trackId, uint8_t direction, uint8_t baseZ) const;
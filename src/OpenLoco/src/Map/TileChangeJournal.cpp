@@ -0,0 +1,40 @@
+#include "TileChangeJournal.h"
+#include <array>
+
+namespace OpenLoco::World::TileChangeJournal
+{
+    static std::array<TileChange, kCapacity> _changes;
+    static uint64_t _head = 0;
+
+    void record(const TilePos2& pos, std::optional<ElementType> type)
+    {
+        _changes[_head % kCapacity] = TileChange{ pos, type };
+        _head++;
+    }
+
+    uint64_t getCursor()
+    {
+        return _head;
+    }
+
+    bool read(uint64_t& cursor, const std::function<void(const TileChange&)>& callback)
+    {
+        if (cursor > _head || _head - cursor > kCapacity)
+        {
+            cursor = _head;
+            return false;
+        }
+
+        for (; cursor < _head; cursor++)
+        {
+            callback(_changes[cursor % kCapacity]);
+        }
+        return true;
+    }
+
+    void reset()
+    {
+        // Skipping a whole buffer makes every cursor taken before now report lost changes.
+        _head += kCapacity + 1;
+    }
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "Tile.h"
+#include <cstdint>
+#include <functional>
+#include <optional>
+
+namespace OpenLoco::World
+{
+    enum class ElementType;
+}
+
+namespace OpenLoco::World::TileChangeJournal
+{
+    // Ring buffer of the tiles that have had elements inserted, removed or modified so that consumers
+    // can update only what changed. Inserts and removes are recorded for all code as the original
+    // functions are hooked, but elements modified in place by original code are not recorded.
+    constexpr uint32_t kCapacity = 4096;
+
+    struct TileChange
+    {
+        TilePos2 pos;
+        std::optional<ElementType> type; // Not known for elements inserted by original code, it sets the type afterwards
+    };
+
+    void record(const TilePos2& pos, std::optional<ElementType> type);
+    // Returns a cursor that will only see changes recorded from now on.
+    uint64_t getCursor();
+    // Calls the callback for every change after the cursor and advances the cursor past them. Returns
+    // false if changes were lost since the cursor was taken, the consumer must then rebuild from the map.
+    // Changes are recorded as they start so only read once the change has finished, e.g. the next tick.
+    bool read(uint64_t& cursor, const std::function<void(const TileChange&)>& callback);
+    // Marks all existing cursors as stale, used when the whole map is replaced.
+    void reset();
+}
@@ -26,6 +26,7 @@
 #include "SignalElement.h"
 #include "StationElement.h"
 #include "SurfaceElement.h"
+#include "TileChangeJournal.h"
 #include "TileClearance.h"
 #include "TrackElement.h"
 #include "TreeElement.h"
@@ -38,7 +39,11 @@
 #include <OpenLoco/Diagnostics/Logging.h>
 #include <OpenLoco/Engine/World.hpp>
 #include <OpenLoco/Interop/Interop.hpp>
+#include <algorithm>
+#include <optional>
 #include <set>
+#include <stdexcept>
+#include <vector>
 
 using namespace OpenLoco::Interop;
 using namespace OpenLoco::Diagnostics;
@@ -58,6 +63,8 @@ namespace OpenLoco::World::TileManager
     static loco_global<int16_t, 0x0050A000> _adjustToolSize;
     static loco_global<World::Pos2, 0x00525F6E> _startUpdateLocation;
 
+    static size_t _elementCapacity = maxElements;
+
     constexpr uint16_t mapSelectedTilesSize = 300;
     static loco_global<Pos2[mapSelectedTilesSize], 0x00F24490> _mapSelectedTiles;
 
@@ -75,7 +82,7 @@ namespace OpenLoco::World::TileManager
     // 0x004BF476
     void allocateMapElements()
     {
-        TileElement* elements = reinterpret_cast<TileElement*>(malloc(0x360000));
+        TileElement* elements = reinterpret_cast<TileElement*>(malloc(maxElements * sizeof(TileElement)));
         if (elements == nullptr)
         {
             exitWithError(StringIds::game_init_failure, StringIds::unable_to_allocate_enough_memory);
@@ -83,6 +90,59 @@ namespace OpenLoco::World::TileManager
         }
 
         _elements = elements;
+        _elementCapacity = maxElements;
+    }
+
+    static TileElement* rebaseElementPointer(TileElement* element, uintptr_t oldElements, TileElement* newElements)
+    {
+        return newElements + (reinterpret_cast<uintptr_t>(element) - oldElements) / sizeof(TileElement);
+    }
+
+    // Moves the elements to a larger buffer, like reorganise this invalidates every element pointer held by the caller.
+    static bool growElements(size_t capacity)
+    {
+        const auto oldElements = reinterpret_cast<uintptr_t>(static_cast<TileElement*>(_elements));
+        const auto oldEnd = reinterpret_cast<uintptr_t>(static_cast<TileElement*>(_elementsEnd));
+        auto* newElements = static_cast<TileElement*>(realloc(_elements, capacity * sizeof(TileElement)));
+        if (newElements == nullptr)
+        {
+            return false;
+        }
+        std::memset(newElements + _elementCapacity, 0, (capacity - _elementCapacity) * sizeof(TileElement));
+
+        for (auto& tile : _tiles)
+        {
+            if (tile != kInvalidTile)
+            {
+                tile = rebaseElementPointer(tile, oldElements, newElements);
+            }
+        }
+        const auto removeChecker = reinterpret_cast<uintptr_t>(static_cast<TileElement*>(_F00158));
+        if (removeChecker >= oldElements && removeChecker < oldEnd)
+        {
+            _F00158 = rebaseElementPointer(_F00158, oldElements, newElements);
+        }
+        _elementsEnd = rebaseElementPointer(_elementsEnd, oldElements, newElements);
+        _elements = newElements;
+        _elementCapacity = capacity;
+
+        Logging::verbose("Grew tile element buffer to {} elements", capacity);
+        return true;
+    }
+
+    // Grows the buffer in steps of doubling so repeated growth stays cheap.
+    static bool growElementsToFit(size_t numElements)
+    {
+        if (numElements > kMaxGrownElements)
+        {
+            return false;
+        }
+        auto capacity = _elementCapacity;
+        while (capacity < numElements)
+        {
+            capacity = std::min(capacity * 2, kMaxGrownElements);
+        }
+        return capacity == _elementCapacity || growElements(capacity);
     }
 
     // 0x00461179
@@ -103,6 +163,7 @@ namespace OpenLoco::World::TileManager
             *element = *reinterpret_cast<TileElement*>(&defaultElement);
         }
         updateTilePointers();
+        TileChangeJournal::reset();
         getGameState().flags |= GameStateFlags::tileManagerLoaded;
     }
 
@@ -141,15 +202,26 @@ namespace OpenLoco::World::TileManager
 
     uint32_t numFreeElements()
     {
-        return maxElements - (_elementsEnd - _elements);
+        return static_cast<uint32_t>(_elementCapacity - (_elementsEnd - _elements));
+    }
+
+    size_t getElementCapacity()
+    {
+        return _elementCapacity;
     }
 
     void setElements(stdx::span<TileElement> elements)
     {
+        if (!growElementsToFit(elements.size()))
+        {
+            throw std::runtime_error("Unable to allocate tile elements");
+        }
+
         TileElement* dst = _elements;
-        std::memset(dst, 0, maxElements * sizeof(TileElement));
+        std::memset(dst, 0, _elementCapacity * sizeof(TileElement));
         std::memcpy(dst, elements.data(), elements.size_bytes());
         TileManager::updateTilePointers();
+        TileChangeJournal::reset();
     }
 
     // Note: Must be past the last tile flag
@@ -162,8 +234,7 @@ namespace OpenLoco::World::TileManager
         }
     }
 
-    // 0x00461760
-    void removeElement(TileElement& element)
+    static void removeElementFromTile(TileElement& element)
     {
         // This is used to indicate if the caller can still use this pointer
         if (&element == *_F00158)
@@ -194,6 +265,13 @@ namespace OpenLoco::World::TileManager
         }
     }
 
+    // 0x00461760
+    void removeElement(TileElement& element, const Pos2& pos)
+    {
+        TileChangeJournal::record(toTileSpace(pos), element.type());
+        removeElementFromTile(element);
+    }
+
     void setRemoveElementPointerChecker(TileElement& element)
     {
         *_F00158 = &element;
@@ -204,17 +282,95 @@ namespace OpenLoco::World::TileManager
         return *_F00158 == kInvalidTile;
     }
 
+    static constexpr size_t getTileIndex(const TilePos2& pos)
+    {
+        // This is the same as (y * kMapPitch) + x
+        return (pos.y << 9) | pos.x;
+    }
+
+    // Original code only passes the element to 0x00461760. The elements of a tile are contiguous so the first
+    // one is found by walking back from the element, the hint is checked first as callers usually still have
+    // the position in ax and cx.
+    static std::optional<TilePos2> findTileOfElement(const TileElement& element, const Pos2& hint)
+    {
+        const auto* first = &element;
+        while (first != *_elements && !(first - 1)->isLast() && (first - 1)->baseZ() != 255)
+        {
+            first--;
+        }
+
+        if (validCoords(hint) && _tiles[getTileIndex(toTileSpace(hint))] == first)
+        {
+            return toTileSpace(hint);
+        }
+        for (tile_coord_t y = 0; y < kMapRows; y++)
+        {
+            for (tile_coord_t x = 0; x < kMapColumns; x++)
+            {
+                if (_tiles[getTileIndex(TilePos2(x, y))] == first)
+                {
+                    return TilePos2(x, y);
+                }
+            }
+        }
+        return std::nullopt;
+    }
+
+    // The tile is moved to the end of the element buffer with the new element placed after the elements
+    // with the same or a lower base height. Callers must have called checkFreeElementsAndReorganise.
+    static TileElement* insertElementIntoTile(const TilePos2& pos, uint8_t baseZ, uint8_t occupiedQuads)
+    {
+        auto& tile = _tiles[getTileIndex(pos)];
+        auto* source = tile;
+        auto* dest = *_elementsEnd;
+        tile = dest;
+
+        // Copy the elements that go below the new element
+        bool isLastForTile = false;
+        while (baseZ >= source->baseZ())
+        {
+            *dest = *source;
+            source->setBaseZ(255);
+            source++;
+            dest++;
+
+            if ((dest - 1)->isLast())
+            {
+                (dest - 1)->setLastFlag(false);
+                isLastForTile = true;
+                break;
+            }
+        }
+
+        auto* newElement = dest++;
+        newElement->rawData() = {};
+        newElement->rawData()[1] = occupiedQuads & 0xF;
+        newElement->setBaseZ(baseZ);
+        newElement->setClearZ(baseZ);
+        newElement->setLastFlag(isLastForTile);
+
+        // Copy the elements that go above the new element
+        if (!isLastForTile)
+        {
+            do
+            {
+                *dest = *source;
+                source->setBaseZ(255);
+                source++;
+                dest++;
+            } while (!(dest - 1)->isLast());
+        }
+
+        _elementsEnd = dest;
+        return newElement;
+    }
+
     // 0x004616D6
     TileElement* insertElement(ElementType type, const Pos2& pos, uint8_t baseZ, uint8_t occupiedQuads)
     {
-        registers regs;
-        regs.ax = pos.x;
-        regs.cx = pos.y;
-        regs.bl = baseZ;
-        regs.bh = occupiedQuads;
-        call(0x004616D6, regs);
-        TileElement* el = X86Pointer<TileElement>(regs.esi);
+        auto* el = insertElementIntoTile(toTileSpace(pos), baseZ, occupiedQuads);
         el->setType(type);
+        TileChangeJournal::record(toTileSpace(pos), type);
         return el;
     }
 
@@ -223,12 +379,6 @@ namespace OpenLoco::World::TileManager
         return _tiles.get();
     }
 
-    static constexpr size_t getTileIndex(const TilePos2& pos)
-    {
-        // This is the same as (y * kMapPitch) + x
-        return (pos.y << 9) | pos.x;
-    }
-
     Tile get(TilePos2 pos)
     {
         const auto index = getTileIndex(pos);
@@ -464,6 +614,20 @@ namespace OpenLoco::World::TileManager
         return baseZ;
     }
 
+    // Tiles are moved towards the front of the element buffer a few at a time so the buffer rarely fills up
+    // and needs a full reorganise. Tiles are visited in buffer order which lets them be moved in place.
+    static constexpr uint32_t kDefragElementsPerTick = 4096;
+
+    // Room a single game command needs to insert its elements, an insert relocates the entire tile to the end of the buffer.
+    static constexpr uint32_t kMinFreeElements = 0x1000;
+
+    static bool _defragActive = false;
+    static size_t _defragRead = 0;
+    static size_t _defragWrite = 0;
+    static size_t _defragLookupEnd = 0;
+    // Tile index + 1 of the tile starting at each element, 0 if no tile starts there.
+    static std::vector<uint32_t> _defragTileAtElement;
+
     static void clearTilePointers()
     {
         std::fill(_tiles.begin(), _tiles.end(), kInvalidTile);
@@ -490,6 +654,82 @@ namespace OpenLoco::World::TileManager
         }
 
         _elementsEnd = el;
+
+        // Every tile may have moved
+        _defragActive = false;
+    }
+
+    static void buildDefragLookup()
+    {
+        _defragTileAtElement.assign(_elementCapacity, 0);
+        for (size_t i = 0; i < _tiles.size(); i++)
+        {
+            const auto* el = _tiles[i];
+            if (el == kInvalidTile)
+            {
+                continue;
+            }
+            _defragTileAtElement[el - _elements] = static_cast<uint32_t>(i + 1);
+        }
+        _defragLookupEnd = _elementsEnd - _elements;
+    }
+
+    static void defragmentElements()
+    {
+        if (!_defragActive)
+        {
+            if (numFreeElements() > _elementCapacity / 8)
+            {
+                return;
+            }
+            _defragActive = true;
+            _defragRead = 0;
+            _defragWrite = 0;
+            buildDefragLookup();
+        }
+
+        TileElement* elements = _elements;
+        const size_t end = _elementsEnd - _elements;
+        uint32_t budget = kDefragElementsPerTick;
+        while (budget > 0 && _defragRead < end)
+        {
+            // Tiles relocated by an insert are appended past the end of the lookup
+            if (_defragRead >= _defragLookupEnd)
+            {
+                buildDefragLookup();
+            }
+
+            auto* el = &elements[_defragRead];
+            const auto tileIndex = _defragTileAtElement[_defragRead];
+            if (tileIndex == 0 || _tiles[tileIndex - 1] != el)
+            {
+                // Free element or the remains of a tile that has since been relocated
+                _defragRead++;
+                budget--;
+                continue;
+            }
+
+            size_t numElements = 1;
+            while (!el[numElements - 1].isLast())
+            {
+                numElements++;
+            }
+            if (_defragWrite != _defragRead)
+            {
+                std::memmove(&elements[_defragWrite], el, numElements * sizeof(TileElement));
+                _tiles[tileIndex - 1] = &elements[_defragWrite];
+            }
+            _defragRead += numElements;
+            _defragWrite += numElements;
+            budget -= std::min<uint32_t>(budget, static_cast<uint32_t>(numElements));
+        }
+
+        if (_defragRead >= end)
+        {
+            std::memset(&elements[_defragWrite], 0, (end - _defragWrite) * sizeof(TileElement));
+            _elementsEnd = &elements[_defragWrite];
+            _defragActive = false;
+        }
     }
 
     // 0x0046148F
@@ -501,7 +741,7 @@ namespace OpenLoco::World::TileManager
         {
             // Allocate a temporary buffer and tighly pack all the tile elements in the map
             std::vector<TileElement> tempBuffer;
-            tempBuffer.resize(maxElements * sizeof(TileElement));
+            tempBuffer.resize(_elementCapacity);
 
             size_t numElements = 0;
             for (tile_coord_t y = 0; y < kMapRows; y++)
@@ -521,7 +761,7 @@ namespace OpenLoco::World::TileManager
             std::memcpy(_elements, tempBuffer.data(), numElements * sizeof(TileElement));
 
             // Zero all unused elements
-            auto remainingElements = maxElements - numElements;
+            auto remainingElements = _elementCapacity - numElements;
             std::memset(_elements + numElements, 0, remainingElements * sizeof(TileElement));
 
             updateTilePointers();
@@ -540,7 +780,25 @@ namespace OpenLoco::World::TileManager
     // 0x00461393
     bool checkFreeElementsAndReorganise()
     {
-        return !(call(0x00461393) & Interop::X86_FLAG_CARRY);
+        if (numFreeElements() > kMinFreeElements)
+        {
+            return true;
+        }
+
+        // Growing does not stall the game like a reorganise does, the defragmentation reclaims the holes over time.
+        if (_elementCapacity < kMaxGrownElements && growElementsToFit(_elementCapacity + 1))
+        {
+            return true;
+        }
+
+        reorganise();
+        if (numFreeElements() > kMinFreeElements)
+        {
+            return true;
+        }
+
+        GameCommands::setErrorText(StringIds::too_many_objects_in_game);
+        return false;
     }
 
     CompanyId getTileOwner(const World::TileElement& el)
@@ -870,15 +1128,11 @@ namespace OpenLoco::World::TileManager
                     continue;
 
                 auto tile = get(tilePos);
-                for (auto& element : tile)
+                for (auto& tree : tile.elementsOfType<TreeElement>())
                 {
                     // NB: vanilla was checking for trees above the surface element.
                     // This has been omitted from our implementation.
-                    auto* tree = element.as<TreeElement>();
-                    if (tree == nullptr)
-                        continue;
-
-                    if (tree->isGhost())
+                    if (tree.isGhost())
                         continue;
 
                     surroundingTrees++;
@@ -899,6 +1153,21 @@ namespace OpenLoco::World::TileManager
         return regs.dx;
     }
 
+    // Every tile has a surface so there are no tiles without anything to update, only the elements in between can be skipped.
+    static constexpr bool hasUpdate(ElementType type)
+    {
+        switch (type)
+        {
+            case ElementType::track:
+            case ElementType::station:
+            case ElementType::signal:
+            case ElementType::wall:
+                return false;
+            default:
+                return true;
+        }
+    }
+
     static bool update(TileElement& el, const World::Pos2& loc)
     {
         registers regs;
@@ -946,6 +1215,8 @@ namespace OpenLoco::World::TileManager
             return;
         }
 
+        defragmentElements();
+
         CompanyManager::setUpdatingCompanyId(CompanyId::neutral);
         auto pos = *_startUpdateLocation;
         for (; pos.y < World::kMapHeight; pos.y += 16 * World::kTileSize)
@@ -955,7 +1226,7 @@ namespace OpenLoco::World::TileManager
                 auto tile = TileManager::get(pos);
                 for (auto& el : tile)
                 {
-                    if (el.isGhost())
+                    if (el.isGhost() || !hasUpdate(el.type()))
                         continue;
 
                     // If update removed/added tiles we must stop loop as pointer is invalid
@@ -1010,7 +1281,7 @@ namespace OpenLoco::World::TileManager
         auto zMax = element.clearHeight();
         Ui::ViewportManager::invalidate(pos, zMin, zMax, ZoomLevel::eighth, 56);
 
-        World::TileManager::removeElement(*reinterpret_cast<World::TileElement*>(&element));
+        World::TileManager::removeElement(*reinterpret_cast<World::TileElement*>(&element), pos);
     }
 
     // 0x0048B0C7
@@ -1061,7 +1332,7 @@ namespace OpenLoco::World::TileManager
             }
         }
         Ui::ViewportManager::invalidate(pos, elBuilding.baseHeight(), elBuilding.clearHeight(), ZoomLevel::eighth);
-        TileManager::removeElement(*reinterpret_cast<TileElement*>(&elBuilding));
+        TileManager::removeElement(*reinterpret_cast<TileElement*>(&elBuilding), pos);
     }
 
     // 0x004C482B
@@ -1069,27 +1340,22 @@ namespace OpenLoco::World::TileManager
     {
         std::vector<World::TileElement*> toDelete;
         auto tile = get(pos);
-        for (auto& el : tile)
+        for (auto& elWall : tile.elementsOfType<WallElement>())
         {
-            auto* elWall = el.as<WallElement>();
-            if (elWall == nullptr)
+            if (baseZ >= elWall.clearZ())
             {
                 continue;
             }
-            if (baseZ >= elWall->clearZ())
+            if (baseZ + 12 < elWall.baseZ())
             {
                 continue;
             }
-            if (baseZ + 12 < elWall->baseZ())
-            {
-                continue;
-            }
-            toDelete.push_back(&el);
+            toDelete.push_back(reinterpret_cast<World::TileElement*>(&elWall));
         }
         // Remove in reverse order to prevent pointer invalidation
         std::for_each(std::rbegin(toDelete), std::rend(toDelete), [&pos](World::TileElement* el) {
             Ui::ViewportManager::invalidate(World::toWorldSpace(pos), el->baseHeight(), el->baseHeight() + 72, ZoomLevel::half);
-            removeElement(*el);
+            removeElement(*el, World::toWorldSpace(pos));
         });
     }
 
@@ -1111,12 +1377,14 @@ namespace OpenLoco::World::TileManager
             surface->setVar4SLR5(0);
 
             Ui::ViewportManager::invalidate(pos, surface->baseHeight(), surface->baseHeight() + 32, ZoomLevel::eighth);
+            TileChangeJournal::record(toTileSpace(pos), ElementType::surface);
         }
         if (surface->var_4_E0() > 0)
         {
             surface->setVar4SLR5(0);
 
             Ui::ViewportManager::invalidate(pos, surface->baseHeight(), surface->baseHeight() + 32, ZoomLevel::eighth);
+            TileChangeJournal::record(toTileSpace(pos), ElementType::surface);
         }
     }
 
@@ -1281,6 +1549,7 @@ namespace OpenLoco::World::TileManager
         surface->setBaseZ(targetBaseZ);
         surface->setClearZ(targetBaseZ);
         surface->setSlope(slopeFlags);
+        TileChangeJournal::record(toTileSpace(pos), ElementType::surface);
 
         landObj = ObjectManager::get<LandObject>(surface->terrain());
         if (landObj->hasFlags(LandObjectFlags::unk1) && !isEditorMode())
@@ -1375,6 +1644,7 @@ namespace OpenLoco::World::TileManager
             }
             surface->setType6Flag(false);
             surface->setVar7(0);
+            TileChangeJournal::record(toTileSpace(pos), ElementType::surface);
 
             mapInvalidateTileFull(pos);
         }
@@ -1404,6 +1674,65 @@ namespace OpenLoco::World::TileManager
                 return 0;
             });
 
+        registerHook(
+            0x00461393,
+            [](registers& regs) FORCE_ALIGN_ARG_POINTER -> uint8_t {
+                registers backup = regs;
+                const auto res = checkFreeElementsAndReorganise();
+                regs = backup;
+                return res ? 0 : X86_FLAG_CARRY;
+            });
+
+        // Hooked so that the incremental defragmentation is aware of the tiles being moved
+        registerHook(
+            0x0046148F,
+            [](registers& regs) FORCE_ALIGN_ARG_POINTER -> uint8_t {
+                registers backup = regs;
+                reorganise();
+                regs = backup;
+                return 0;
+            });
+
+        registerHook(
+            0x00461348,
+            [](registers& regs) FORCE_ALIGN_ARG_POINTER -> uint8_t {
+                registers backup = regs;
+                updateTilePointers();
+                regs = backup;
+                return 0;
+            });
+
+        registerHook(
+            0x004616D6,
+            [](registers& regs) FORCE_ALIGN_ARG_POINTER -> uint8_t {
+                registers backup = regs;
+                const auto pos = Pos2(regs.ax, regs.cx);
+                auto* el = insertElementIntoTile(toTileSpace(pos), regs.bl, regs.bh);
+                TileChangeJournal::record(toTileSpace(pos), std::nullopt);
+                regs = backup;
+                regs.esi = X86Pointer(el);
+                return 0;
+            });
+
+        registerHook(
+            0x00461760,
+            [](registers& regs) FORCE_ALIGN_ARG_POINTER -> uint8_t {
+                registers backup = regs;
+                auto& element = *X86Pointer<TileElement>(regs.esi);
+                if (const auto tilePos = findTileOfElement(element, Pos2(regs.ax, regs.cx)))
+                {
+                    TileChangeJournal::record(*tilePos, element.type());
+                }
+                else
+                {
+                    Logging::error("Removed element is not part of any tile");
+                    TileChangeJournal::reset();
+                }
+                removeElementFromTile(element);
+                regs = backup;
+                return 0;
+            });
+
         registerHook(
             0x0046902E,
             [](registers& regs) FORCE_ALIGN_ARG_POINTER -> uint8_t {
@@ -17,7 +17,9 @@ namespace OpenLoco::World
 
 namespace OpenLoco::World::TileManager
 {
+    // Capacity of the original element buffer, the buffer grows beyond it when it fills up.
     constexpr size_t maxElements = 0x6C000;
+    constexpr size_t kMaxGrownElements = maxElements * 8;
     TileElement* const kInvalidTile = reinterpret_cast<TileElement*>(static_cast<intptr_t>(-1));
 
     enum class ElementPositionFlags : uint8_t
@@ -37,12 +39,13 @@ namespace OpenLoco::World::TileManager
     stdx::span<TileElement> getElements();
     TileElement* getElementsEnd();
     uint32_t numFreeElements();
+    size_t getElementCapacity();
     TileElement** getElementIndex();
     Tile get(TilePos2 pos);
     Tile get(Pos2 pos);
     Tile get(coord_t x, coord_t y);
     void setElements(stdx::span<TileElement> elements);
-    void removeElement(TileElement& element);
+    void removeElement(TileElement& element, const Pos2& pos);
     // This is used with wasRemoveOnLastElement to indicate that pointer passed to removeElement is now bad
     void setRemoveElementPointerChecker(TileElement& element);
     // See above. Used to indicate if pointer to removeElement is now bad
@@ -1,4 +1,5 @@
 #include "Track.h"
+#include "GameCommands/GameCommands.h"
 #include "Map/RoadElement.h"
 #include "Map/SignalElement.h"
 #include "Map/StationElement.h"
@@ -6,6 +7,9 @@
 #include "Map/TrackElement.h"
 #include "TrackData.h"
 #include <OpenLoco/Interop/Interop.hpp>
+#include <functional>
+#include <optional>
+#include <unordered_map>
 
 using namespace OpenLoco::Interop;
 
@@ -29,7 +33,7 @@ namespace OpenLoco::World::Track
     static loco_global<uint8_t, 0x0113607D> _113607D;
 
     // 0x00478895
-    void getRoadConnections(const World::Pos3& pos, TrackConnections& data, const CompanyId company, const uint8_t roadObjectId, const uint16_t trackAndDirection)
+    static void findRoadConnections(const World::Pos3& pos, TrackConnections& data, const CompanyId company, const uint8_t roadObjectId, const uint16_t trackAndDirection)
     {
         const auto nextTrackPos = pos + TrackData::getUnkRoad(trackAndDirection).pos;
         _1135FAE = StationId::null; // stationId
@@ -171,7 +175,7 @@ namespace OpenLoco::World::Track
     }
 
     // 0x004A2638, 0x004A2601
-    void getTrackConnections(const World::Pos3& nextTrackPos, const uint8_t nextRotation, TrackConnections& data, const CompanyId company, const uint8_t trackObjectId)
+    static void findTrackConnections(const World::Pos3& nextTrackPos, const uint8_t nextRotation, TrackConnections& data, const CompanyId company, const uint8_t trackObjectId)
     {
         _1135FAE = StationId::null; // stationId
         _113607D = 0;
@@ -326,6 +330,148 @@ namespace OpenLoco::World::Track
             data.push_back(trackAndDirection2);
         }
     }
+
+    // The connections found on a tile only depend on the track and road elements, which are only built
+    // or removed by game commands. They are kept until the next game command is applied and are not used
+    // while a command is running as its elements can be half built.
+    struct ConnectionKey
+    {
+        World::Pos3 pos;
+        uint16_t direction; // Rotation for track, track and direction for road
+        CompanyId company;
+        uint8_t objectId;
+        uint8_t requiredMods;
+        uint8_t compareMods;
+        uint32_t sharedRoadObjects;
+        bool isRoad;
+
+        bool operator==(const ConnectionKey& rhs) const
+        {
+            return pos == rhs.pos && direction == rhs.direction && company == rhs.company
+                && objectId == rhs.objectId && requiredMods == rhs.requiredMods && compareMods == rhs.compareMods
+                && sharedRoadObjects == rhs.sharedRoadObjects && isRoad == rhs.isRoad;
+        }
+    };
+
+    struct ConnectionKeyHash
+    {
+        std::size_t operator()(const ConnectionKey& key) const noexcept
+        {
+            const uint64_t packed = (static_cast<uint64_t>(static_cast<uint16_t>(key.pos.x)) << 48)
+                | (static_cast<uint64_t>(static_cast<uint16_t>(key.pos.y)) << 32)
+                | (static_cast<uint64_t>(static_cast<uint16_t>(key.pos.z)) << 16)
+                | key.direction;
+            const uint64_t packed2 = (static_cast<uint64_t>(key.sharedRoadObjects) << 32)
+                | (static_cast<uint64_t>(enumValue(key.company)) << 24) | (key.objectId << 16) | (key.requiredMods << 8) | key.compareMods;
+            return std::hash<uint64_t>{}(packed ^ (packed2 * 0x9E3779B97F4A7C15ULL) ^ (key.isRoad ? 1 : 0));
+        }
+    };
+
+    // The found connections and the values passed back through the globals.
+    struct ConnectionEntry
+    {
+        TrackConnections connections;
+        StationId stationId;
+        uint16_t stationObjectId;
+        std::optional<uint8_t> roadObjectId;
+        uint8_t hasUnk6_10;
+    };
+
+    static constexpr size_t kMaxCachedConnections = 0x10000;
+    static std::unordered_map<ConnectionKey, ConnectionEntry, ConnectionKeyHash> _connections;
+
+    void invalidateConnections()
+    {
+        _connections.clear();
+    }
+
+    static void copyConnections(const TrackConnections& src, TrackConnections& dst)
+    {
+        for (uint32_t i = 0; i < src.size; i++)
+        {
+            dst.push_back(src.data[i]);
+        }
+    }
+
+    void getRoadConnections(const World::Pos3& pos, TrackConnections& data, const CompanyId company, const uint8_t roadObjectId, const uint16_t trackAndDirection)
+    {
+        if (GameCommands::getCommandNestLevel() != 0)
+        {
+            findRoadConnections(pos, data, company, roadObjectId, trackAndDirection);
+            return;
+        }
+
+        const ConnectionKey key{ pos, trackAndDirection, company, roadObjectId, _113601A[0], _113601A[1], _525FC0, true };
+        auto it = _connections.find(key);
+        if (it == _connections.end())
+        {
+            if (_connections.size() >= kMaxCachedConnections)
+            {
+                _connections.clear();
+            }
+
+            ConnectionEntry entry{};
+            const auto oldRoadObjectId = *_112C2ED;
+            _112C2ED = 0xFF;
+            findRoadConnections(pos, entry.connections, company, roadObjectId, trackAndDirection);
+            entry.stationId = _1135FAE;
+            entry.stationObjectId = _1136087;
+            // The road object is only passed back when a connection at the start of a piece was found.
+            for (uint32_t i = 0; i < entry.connections.size; i++)
+            {
+                if (!(entry.connections.data[i] & (1 << 2)))
+                {
+                    entry.roadObjectId = _112C2ED;
+                    break;
+                }
+            }
+            _112C2ED = oldRoadObjectId;
+            it = _connections.emplace(key, entry).first;
+        }
+
+        const auto& entry = it->second;
+        copyConnections(entry.connections, data);
+        _112C2EE = TrackData::getUnkRoad(trackAndDirection).rotationEnd;
+        _1135FAE = entry.stationId;
+        if (entry.stationId != StationId::null)
+        {
+            _1136087 = entry.stationObjectId;
+        }
+        if (entry.roadObjectId)
+        {
+            _112C2ED = *entry.roadObjectId;
+        }
+    }
+
+    void getTrackConnections(const World::Pos3& nextTrackPos, const uint8_t nextRotation, TrackConnections& data, const CompanyId company, const uint8_t trackObjectId)
+    {
+        if (GameCommands::getCommandNestLevel() != 0)
+        {
+            findTrackConnections(nextTrackPos, nextRotation, data, company, trackObjectId);
+            return;
+        }
+
+        const ConnectionKey key{ nextTrackPos, nextRotation, company, trackObjectId, _113601A[0], _113601A[1], 0, false };
+        auto it = _connections.find(key);
+        if (it == _connections.end())
+        {
+            if (_connections.size() >= kMaxCachedConnections)
+            {
+                _connections.clear();
+            }
+
+            ConnectionEntry entry{};
+            findTrackConnections(nextTrackPos, nextRotation, entry.connections, company, trackObjectId);
+            entry.stationId = _1135FAE;
+            entry.hasUnk6_10 = _113607D;
+            it = _connections.emplace(key, entry).first;
+        }
+
+        const auto& entry = it->second;
+        copyConnections(entry.connections, data);
+        _1135FAE = entry.stationId;
+        _113607D = entry.hasUnk6_10;
+    }
 }
 
 namespace OpenLoco::World
@@ -1,10 +1,13 @@
 #include "NetworkClient.h"
 #include "Config.h"
 #include "GameCommands/GameCommands.h"
+#include "GameState.h"
 #include "Logging.h"
 #include "NetworkConnection.h"
 #include "S5/S5.h"
+#include "ScenarioManager.h"
 #include "SceneManager.h"
+#include "StateHash.h"
 #include "Ui/WindowManager.h"
 #include <OpenLoco/Core/BinaryStream.h>
 #include <OpenLoco/Platform/Platform.h>
@@ -95,6 +98,9 @@ void NetworkClient::onUpdate()
                     break;
                 case NetworkClientStatus::waitingForState:
                     break;
+                case NetworkClientStatus::connected:
+                    checkStateHash();
+                    break;
                 default:
                     break;
             }
@@ -289,6 +295,33 @@ void NetworkClient::receivePingPacket(const PingPacket& packet)
         // No pending game commands, we can update to this tick
         _localTick = packet.tick;
     }
+
+    // The server is usually ahead, keep the state hash until we have reached the same tick.
+    if (!_pendingStateCheck)
+    {
+        _pendingStateCheck = packet;
+    }
+}
+
+void NetworkClient::checkStateHash()
+{
+    if (!_pendingStateCheck)
+        return;
+
+    const auto tick = ScenarioManager::getScenarioTicks();
+    if (tick < _pendingStateCheck->tick)
+        return;
+
+    if (tick == _pendingStateCheck->tick)
+    {
+        auto& gameState = getGameState();
+        const auto localHash = StateHash::compute();
+        if (gameState.rng.srand_0() != _pendingStateCheck->srand0 || gameState.rng.srand_1() != _pendingStateCheck->srand1 || localHash != _pendingStateCheck->stateHash)
+        {
+            Logging::error("Desync detected at tick {}, mismatched state: {}", tick, StateHash::getMismatchedSubsystems(localHash, _pendingStateCheck->stateHash));
+        }
+    }
+    _pendingStateCheck = std::nullopt;
 }
 
 void NetworkClient::receiveGameCommandPacket(const GameCommandPacket& packet)
@@ -6,6 +6,7 @@
 #include <OpenLoco/Core/Span.hpp>
 #include <cstdint>
 #include <list>
+#include <optional>
 #include <vector>
 
 namespace OpenLoco::Network
@@ -34,6 +35,7 @@ namespace OpenLoco::Network
         uint32_t _localTick;
         uint32_t _serverTick;
         std::list<GameCommandPacket> _receivedGameCommands;
+        std::optional<PingPacket> _pendingStateCheck;
 
         struct ReceivedChunk
         {
@@ -54,6 +56,7 @@ namespace OpenLoco::Network
         void onReceivePacketFromServer(const Packet& packet);
         void processFullState(stdx::span<uint8_t const> data);
         void updateLocalTick();
+        void checkStateHash();
 
         void initStatus(std::string_view text);
         void setStatus(std::string_view text);
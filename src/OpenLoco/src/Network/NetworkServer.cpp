@@ -227,6 +227,14 @@ void NetworkServer::sendPings()
         packet.tick = gameState.scenarioTicks;
         packet.srand0 = gameState.rng.srand_0();
         packet.srand1 = gameState.rng.srand_1();
+
+        // Pings are sent more often than ticks, only hash the state once per tick.
+        if (_lastStateHashTick != gameState.scenarioTicks)
+        {
+            _lastStateHashTick = gameState.scenarioTicks;
+            _lastStateHash = StateHash::compute();
+        }
+        packet.stateHash = _lastStateHash;
         for (auto& client : _clients)
         {
             client->connection->sendPacket(packet);
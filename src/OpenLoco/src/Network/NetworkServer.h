@@ -4,7 +4,9 @@
 #include "NetworkBase.h"
 #include "NetworkConnection.h"
 #include "Socket.h"
+#include "StateHash.h"
 #include <mutex>
+#include <optional>
 
 namespace OpenLoco::Network
 {
@@ -34,6 +36,8 @@ namespace OpenLoco::Network
         std::queue<ChatMessage> _chatMessageQueue;
         client_id_t _nextClientId = 1;
         uint32_t _lastPing{};
+        std::optional<uint32_t> _lastStateHashTick;
+        StateHash::Digest _lastStateHash{};
         uint32_t _gameCommandIndex{};
         std::queue<GameCommandPacket> _gameCommands;
 
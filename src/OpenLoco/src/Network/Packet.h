@@ -5,6 +5,7 @@
 #include <string_view>
 
 #include "Network.h"
+#include "StateHash.h"
 #include <OpenLoco/Interop/Interop.hpp>
 
 namespace OpenLoco::Network
@@ -67,6 +68,7 @@ namespace OpenLoco::Network
         uint32_t tick{};
         uint32_t srand0{};
         uint32_t srand1{};
+        StateHash::Digest stateHash{};
     };
 
     struct ConnectPacket
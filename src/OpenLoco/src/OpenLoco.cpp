@@ -4,6 +4,7 @@
 #include <cassert>
 #include <chrono>
 #include <cstring>
+#include <future>
 #include <iostream>
 #include <setjmp.h>
 #include <string>
@@ -34,6 +35,7 @@
 #include "Entities/EntityTweener.h"
 #include "Environment.h"
 #include "Game.h"
+#include "GameCommands/GameCommands.h"
 #include "GameException.hpp"
 #include "GameState.h"
 #include "GameStateFlags.h"
@@ -50,6 +52,7 @@
 #include "Localisation/StringIds.h"
 #include "Logging.h"
 #include "Map/AnimationManager.h"
+#include "Map/SurfaceElement.h"
 #include "Map/TileManager.h"
 #include "Map/WaveManager.h"
 #include "MessageManager.h"
@@ -59,9 +62,11 @@
 #include "Objects/ObjectManager.h"
 #include "OpenLoco.h"
 #include "Random.h"
+#include "Replay.h"
 #include "S5/S5.h"
 #include "ScenarioManager.h"
 #include "SceneManager.h"
+#include "StateHash.h"
 #include "Title.h"
 #include "Tutorial.h"
 #include "Ui.h"
@@ -73,7 +78,10 @@
 #include "World/IndustryManager.h"
 #include "World/StationManager.h"
 #include "World/TownManager.h"
+#include <OpenLoco/Core/BinaryStream.h>
+#include <OpenLoco/Core/FileStream.h>
 #include <OpenLoco/Core/Numerics.hpp>
+#include <OpenLoco/Diagnostics/Profiling.h>
 #include <OpenLoco/Interop/Interop.hpp>
 #include <OpenLoco/Platform/Crash.h>
 #include <OpenLoco/Platform/Platform.h>
@@ -94,6 +102,7 @@ namespace OpenLoco
     static double _accumulator = 0.0;
     static Timepoint _lastUpdate = Clock::now();
     static CrashHandler::Handle _exHandler = nullptr;
+    static bool _isHeadless = false; // Skips all audio and ui work, used when simulating
 
     loco_global<char[256], 0x005060D0> _gCDKey;
 
@@ -110,9 +119,19 @@ namespace OpenLoco
     static loco_global<char[256], 0x011367A0> _11367A0;
     static loco_global<char[256], 0x011368A0> _11368A0;
 
+    // Logging is not thread safe so the autosave worker passes its messages back to the game thread.
+    struct AutosaveMessage
+    {
+        bool isError;
+        std::string text;
+    };
+
     static int32_t _monthsSinceLastAutosave;
+    static std::future<std::vector<AutosaveMessage>> _autosaveTask;
 
     static void autosaveReset();
+    static void autosaveWait();
+    static void autosavePoll();
     static void tickLogic(int32_t count);
     static void tickLogic();
     static void dateTick();
@@ -211,6 +230,19 @@ namespace OpenLoco
     // 0x004BE65E
     [[noreturn]] void exitCleanly()
     {
+        Replay::stopRecording();
+        autosaveWait();
+
+        const auto& tracePath = getCommandLineOptions().tracePath;
+        if (!tracePath.empty())
+        {
+            Profiling::setEnabled(false);
+            if (!Profiling::exportChromeTrace(fs::u8path(tracePath)))
+            {
+                Logging::error("Unable to write trace to {}", tracePath);
+            }
+        }
+
         Audio::disposeDSound();
         Audio::close();
         Ui::disposeCursors();
@@ -300,9 +332,15 @@ namespace OpenLoco
         Gfx::initialiseNoiseMaskMap();
         Ui::ProgressBar::setProgress(235);
         Ui::ProgressBar::setProgress(250);
-        Ui::initialiseCursors();
+        if (!_isHeadless)
+        {
+            Ui::initialiseCursors();
+        }
         Ui::ProgressBar::end();
-        Ui::initialise();
+        if (!_isHeadless)
+        {
+            Ui::initialise();
+        }
         initialiseViewports();
         Title::sub_4284C8();
         call(0x004969DA); // getLocalTime not used (dead code?)
@@ -555,6 +593,7 @@ namespace OpenLoco
                 _time_since_last_tick = 31;
             }
             _game_command_nest_level = 0;
+            autosavePoll();
             Ui::update();
 
             addr<0x005233AE, int32_t>() += addr<0x0114084C, int32_t>();
@@ -770,33 +809,88 @@ namespace OpenLoco
         if (!Network::shouldProcessTick(ScenarioManager::getScenarioTicks() + 1))
             return;
 
+        OPENLOCO_PROFILE_SCOPE("tickLogic");
+
+        Replay::beginTick();
         ScenarioManager::setScenarioTicks(ScenarioManager::getScenarioTicks() + 1);
         ScenarioManager::setScenarioTicks2(ScenarioManager::getScenarioTicks2() + 1);
-        Network::processGameCommands(ScenarioManager::getScenarioTicks());
+        {
+            OPENLOCO_PROFILE_SCOPE("Network::processGameCommands");
+            Network::processGameCommands(ScenarioManager::getScenarioTicks());
+        }
 
         recordTickStartPrng();
-        call(0x004613F0); // Map::TileManager::reorg?
+        {
+            OPENLOCO_PROFILE_SCOPE("sub_4613F0");
+            call(0x004613F0); // Map::TileManager::reorg?
+        }
         addr<0x00F25374, uint8_t>() = S5::getOptions().madeAnyChanges;
-        dateTick();
-        World::TileManager::update();
-        World::WaveManager::update();
-        TownManager::update();
-        IndustryManager::update();
-        VehicleManager::update();
+        {
+            OPENLOCO_PROFILE_SCOPE("dateTick");
+            dateTick();
+        }
+        {
+            OPENLOCO_PROFILE_SCOPE("TileManager::update");
+            World::TileManager::update();
+        }
+        {
+            OPENLOCO_PROFILE_SCOPE("WaveManager::update");
+            World::WaveManager::update();
+        }
+        {
+            OPENLOCO_PROFILE_SCOPE("TownManager::update");
+            TownManager::update();
+        }
+        {
+            OPENLOCO_PROFILE_SCOPE("IndustryManager::update");
+            IndustryManager::update();
+        }
+        {
+            OPENLOCO_PROFILE_SCOPE("VehicleManager::update");
+            VehicleManager::update();
+        }
         sub_46FFCA();
-        StationManager::update();
-        EffectsManager::update();
+        {
+            OPENLOCO_PROFILE_SCOPE("StationManager::update");
+            StationManager::update();
+        }
+        {
+            OPENLOCO_PROFILE_SCOPE("EffectsManager::update");
+            EffectsManager::update();
+        }
         sub_46FFCA();
-        CompanyManager::update();
-        World::AnimationManager::update();
-        Audio::updateVehicleNoise();
-        Audio::updateAmbientNoise();
-        Title::update();
+        {
+            OPENLOCO_PROFILE_SCOPE("CompanyManager::update");
+            CompanyManager::update();
+        }
+        {
+            OPENLOCO_PROFILE_SCOPE("AnimationManager::update");
+            World::AnimationManager::update();
+        }
+        if (!_isHeadless)
+        {
+            {
+                OPENLOCO_PROFILE_SCOPE("Audio::updateVehicleNoise");
+                Audio::updateVehicleNoise();
+            }
+            {
+                OPENLOCO_PROFILE_SCOPE("Audio::updateAmbientNoise");
+                Audio::updateAmbientNoise();
+            }
+        }
+        {
+            OPENLOCO_PROFILE_SCOPE("Title::update");
+            Title::update();
+        }
 
         S5::getOptions().madeAnyChanges = addr<0x00F25374, uint8_t>();
         if (_loadErrorCode != 0)
         {
-            if (_loadErrorCode == -2)
+            if (_isHeadless)
+            {
+                Logging::error("Object load error {}", _loadErrorCode);
+            }
+            else if (_loadErrorCode == -2)
             {
                 string_id title = _loadErrorMessage;
                 string_id message = StringIds::null;
@@ -809,6 +903,8 @@ namespace OpenLoco
             }
             _loadErrorCode = 0;
         }
+
+        Replay::endTick();
     }
 
     static void autosaveReset()
@@ -816,11 +912,44 @@ namespace OpenLoco
         _monthsSinceLastAutosave = 0;
     }
 
-    static void autosaveClean()
+    static void logAutosaveMessages(const std::vector<AutosaveMessage>& messages)
+    {
+        for (const auto& message : messages)
+        {
+            if (message.isError)
+            {
+                Logging::error("{}", message.text);
+            }
+            else
+            {
+                Logging::info("{}", message.text);
+            }
+        }
+    }
+
+    // Blocks until the autosave currently being written, if any, has finished.
+    static void autosaveWait()
+    {
+        if (_autosaveTask.valid())
+        {
+            OPENLOCO_PROFILE_SCOPE("autosaveWait");
+            logAutosaveMessages(_autosaveTask.get());
+        }
+    }
+
+    // Logs the messages of a finished autosave without waiting for one that is still being written.
+    static void autosavePoll()
+    {
+        if (_autosaveTask.valid() && _autosaveTask.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+        {
+            logAutosaveMessages(_autosaveTask.get());
+        }
+    }
+
+    static void autosaveClean(const fs::path& autosaveDirectory, size_t amountToKeep, std::vector<AutosaveMessage>& messages)
     {
         try
         {
-            auto autosaveDirectory = Environment::getPath(Environment::PathId::autosave);
             if (fs::is_directory(autosaveDirectory))
             {
                 std::vector<fs::path> autosaveFiles;
@@ -839,7 +968,6 @@ namespace OpenLoco
                     }
                 }
 
-                auto amountToKeep = static_cast<size_t>(std::max(1, Config::get().autosaveAmount));
                 if (autosaveFiles.size() > amountToKeep)
                 {
                     // Sort them by name (which should correspond to date order)
@@ -850,7 +978,7 @@ namespace OpenLoco
                     for (size_t i = 0; i < numToDelete; i++)
                     {
                         auto path8 = autosaveFiles[i].u8string();
-                        Logging::info("Deleting old autosave: {}", path8.c_str());
+                        messages.push_back(AutosaveMessage{ false, fmt::format("Deleting old autosave: {}", path8.c_str()) });
                         fs::remove(autosaveFiles[i]);
                     }
                 }
@@ -858,7 +986,7 @@ namespace OpenLoco
         }
         catch (const std::exception& e)
         {
-            Logging::error("Unable to clean autosaves: {}", e.what());
+            messages.push_back(AutosaveMessage{ true, fmt::format("Unable to clean autosaves: {}", e.what()) });
         }
     }
 
@@ -880,6 +1008,9 @@ namespace OpenLoco
             localTime->tm_sec,
             S5::extensionSV5);
 
+        // Only one autosave is written at a time, if the previous one is still being written wait for it.
+        autosaveWait();
+
         try
         {
             auto autosaveDirectory = Environment::getPath(Environment::PathId::autosave);
@@ -889,7 +1020,31 @@ namespace OpenLoco
 
             auto autosaveFullPath8 = autosaveFullPath.u8string();
             Logging::info("Autosaving game to {}", autosaveFullPath8.c_str());
-            S5::exportGameStateToFile(autosaveFullPath, S5::SaveFlags::noWindowClose);
+
+            // Only the snapshot is taken on the game thread, encoding and writing the file happens on a worker.
+            std::shared_ptr<S5::S5File> snapshot;
+            {
+                OPENLOCO_PROFILE_SCOPE("autosaveSnapshot");
+                snapshot = S5::createSnapshot(S5::SaveFlags::noWindowClose);
+            }
+            const auto amountToKeep = static_cast<size_t>(std::max(1, Config::get().autosaveAmount));
+
+            // No profiling zone on the worker, the profiler keeps a buffer for every thread that records and each autosave is a new thread.
+            _autosaveTask = std::async(std::launch::async, [snapshot, autosaveDirectory, autosaveFullPath, amountToKeep]() {
+                std::vector<AutosaveMessage> messages;
+                try
+                {
+                    FileStream stream(autosaveFullPath, StreamMode::write);
+                    S5::writeSnapshot(stream, *snapshot);
+                }
+                catch (const std::exception& e)
+                {
+                    messages.push_back(AutosaveMessage{ true, fmt::format("Unable to autosave game: {}", e.what()) });
+                    return messages;
+                }
+                autosaveClean(autosaveDirectory, amountToKeep, messages);
+                return messages;
+            });
         }
         catch (const std::exception& e)
         {
@@ -907,7 +1062,6 @@ namespace OpenLoco
             if (freq > 0 && _monthsSinceLastAutosave >= freq)
             {
                 autosave();
-                autosaveClean();
             }
         }
     }
@@ -1116,8 +1270,11 @@ namespace OpenLoco
         _glpCmdLine = "";
     }
 
-    void simulateGame(const fs::path& path, int32_t ticks)
+    // Prepares the game for running ticks without the main loop and loads the game using the given function.
+    static void initialiseSimulation(bool headless, const std::function<void()>& load)
     {
+        _isHeadless = headless;
+
         Config::read();
         Environment::resolvePaths();
         resetCmdline();
@@ -1126,7 +1283,7 @@ namespace OpenLoco
         try
         {
             initialise();
-            loadFile(path);
+            load();
         }
         catch (const std::exception& e)
         {
@@ -1143,7 +1300,169 @@ namespace OpenLoco
                 Logging::info("File loaded. Starting simulation.");
             }
         }
-        tickLogic(ticks);
+    }
+
+    static void simulateTick(const std::function<void(uint64_t)>& onTickComplete)
+    {
+        const auto tickStarted = Clock::now();
+        tickLogic();
+        if (onTickComplete)
+        {
+            onTickComplete(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - tickStarted).count());
+        }
+    }
+
+    void simulateGame(const fs::path& path, int32_t ticks, bool headless, const std::function<void(uint64_t)>& onTickComplete)
+    {
+        initialiseSimulation(headless, [&path]() { loadFile(path); });
+
+        for (int32_t i = 0; i < ticks; i++)
+        {
+            simulateTick(onTickComplete);
+        }
+    }
+
+    std::optional<uint32_t> replayGame(const fs::path& path, bool headless, const std::function<void(uint64_t)>& onTickComplete)
+    {
+        std::unique_ptr<Replay::ReplayFile> replay;
+        try
+        {
+            replay = Replay::readReplay(path);
+        }
+        catch (const std::exception& e)
+        {
+            Logging::error("Unable to read replay: {}", e.what());
+            return std::nullopt;
+        }
+
+        initialiseSimulation(headless, [&replay]() {
+            BinaryStream stream(replay->save.data(), replay->save.size());
+            S5::importSaveToGameState(stream, S5::LoadFlags::none);
+        });
+
+        if (ScenarioManager::getScenarioTicks() != replay->startTick)
+        {
+            Logging::error("Replay save could not be loaded");
+            return std::nullopt;
+        }
+
+        uint32_t numMismatches = 0;
+        auto nextCommand = replay->commands.begin();
+        auto nextCheckpoint = replay->checkpoints.begin();
+        while (ScenarioManager::getScenarioTicks() < replay->endTick)
+        {
+            simulateTick(onTickComplete);
+
+            // Checkpoints were taken at the end of the tick, before any player commands were run.
+            const auto tick = ScenarioManager::getScenarioTicks();
+            if (nextCheckpoint != replay->checkpoints.end() && nextCheckpoint->tick == tick)
+            {
+                const auto actual = Replay::createCheckpoint();
+                if (actual.srand0 != nextCheckpoint->srand0 || actual.srand1 != nextCheckpoint->srand1 || actual.state != nextCheckpoint->state)
+                {
+                    Logging::error("Replay diverged at tick {}: rng {{ {}, {} }} expected {{ {}, {} }}, mismatched state: {}", tick, actual.srand0, actual.srand1, nextCheckpoint->srand0, nextCheckpoint->srand1, StateHash::getMismatchedSubsystems(actual.state, nextCheckpoint->state));
+                    numMismatches++;
+                }
+                nextCheckpoint++;
+            }
+
+            for (; nextCommand != replay->commands.end() && nextCommand->tick == tick; nextCommand++)
+            {
+                GameCommands::doCommandForReal(static_cast<GameCommands::GameCommand>(nextCommand->regs.esi), nextCommand->company, nextCommand->regs);
+            }
+        }
+
+        Logging::info("Replay verified {} checkpoints, {} mismatched", replay->checkpoints.size(), numMismatches);
+        return numMismatches;
+    }
+
+    void benchmarkTileElements(const fs::path& path, bool headless, const std::function<void(uint64_t)>& onInsert, const std::function<void(uint64_t)>& onRemove)
+    {
+        initialiseSimulation(headless, [&path]() { loadFile(path); });
+        if (!Game::hasFlags(GameStateFlags::tileManagerLoaded))
+        {
+            Logging::error("Benchmark save could not be loaded");
+            return;
+        }
+
+        // Ghost elements are spread over the whole map so tiles keep being relocated to the end of the
+        // buffer like they are when building, the check before each insert is what game commands do.
+        World::TileManager::reorganise();
+        auto numElements = World::TileManager::getElementCapacity() - World::TileManager::numFreeElements();
+        std::vector<World::Pos2> positions;
+        for (size_t i = 0; numElements < World::TileManager::maxElements * 2; i++, numElements++)
+        {
+            const auto tileIndex = static_cast<int32_t>(i % (World::kMapColumns * World::kMapRows));
+            const auto tilePos = World::TilePos2(static_cast<tile_coord_t>(tileIndex % World::kMapColumns), static_cast<tile_coord_t>(tileIndex / World::kMapColumns));
+            const auto pos = World::toWorldSpace(tilePos);
+            const auto* surface = World::TileManager::get(pos).surface();
+            if (surface == nullptr)
+            {
+                Logging::error("Tile {}, {} has no surface element", tilePos.x, tilePos.y);
+                break;
+            }
+            const auto baseZ = surface->baseZ() + 4;
+
+            const auto insertStarted = Clock::now();
+            if (!World::TileManager::checkFreeElementsAndReorganise())
+            {
+                Logging::error("Element buffer full after {} inserts", positions.size());
+                break;
+            }
+            auto* element = World::TileManager::insertElement(World::ElementType::tree, pos, baseZ, 0xF);
+            element->setGhost(true);
+            if (onInsert)
+            {
+                onInsert(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - insertStarted).count());
+            }
+            positions.push_back(pos);
+        }
+
+        for (auto it = positions.rbegin(); it != positions.rend(); ++it)
+        {
+            const auto removeStarted = Clock::now();
+            auto tile = World::TileManager::get(*it);
+            for (auto& element : tile)
+            {
+                if (element.isGhost())
+                {
+                    World::TileManager::removeElement(element, *it);
+                    break;
+                }
+            }
+            if (onRemove)
+            {
+                onRemove(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - removeStarted).count());
+            }
+        }
+    }
+
+    void benchmarkStateHash(const fs::path& path, bool headless, int32_t iterations, const std::function<void(uint64_t)>& onHash)
+    {
+        initialiseSimulation(headless, [&path]() { loadFile(path); });
+        if (!Game::hasFlags(GameStateFlags::tileManagerLoaded))
+        {
+            Logging::error("Benchmark save could not be loaded");
+            return;
+        }
+
+        uint64_t combined = 0;
+        for (int32_t i = 0; i < iterations; i++)
+        {
+            const auto hashStarted = Clock::now();
+            const auto digest = StateHash::compute();
+            if (onHash)
+            {
+                onHash(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - hashStarted).count());
+            }
+            // The state does not change between iterations so neither should the hash.
+            if (i != 0 && digest.combined() != combined)
+            {
+                Logging::error("State hash changed between iterations without the state changing");
+                return;
+            }
+            combined = digest.combined();
+        }
     }
 
     // 0x00406D13
@@ -1162,6 +1481,11 @@ namespace OpenLoco
         }
 
         setCommandLineOptions(options);
+        Profiling::setEnabled(!options.tracePath.empty());
+        if (!options.recordPath.empty())
+        {
+            Replay::requestRecording(fs::u8path(options.recordPath));
+        }
 
         if (!OpenLoco::Platform::isRunningInWine())
         {
@@ -3,6 +3,7 @@
 #include <OpenLoco/Core/FileSystem.hpp>
 #include <cstdint>
 #include <functional>
+#include <optional>
 #include <string>
 
 namespace OpenLoco
@@ -22,7 +23,16 @@ namespace OpenLoco
 
     void* hInstance();
     void initialiseViewports();
-    void simulateGame(const fs::path& path, int32_t ticks);
+    // Loads the given file and runs the requested number of ticks, the callback receives the duration of each tick in nanoseconds.
+    // A headless simulation skips all audio and ui work so it can run without a display or sound device.
+    void simulateGame(const fs::path& path, int32_t ticks, bool headless = false, const std::function<void(uint64_t)>& onTickComplete = {});
+    // Re-runs a recorded replay verifying its checkpoints, returns the number of mismatching checkpoints or nothing if it failed to load.
+    std::optional<uint32_t> replayGame(const fs::path& path, bool headless = false, const std::function<void(uint64_t)>& onTickComplete = {});
+    // Loads the given file, fills the map with ghost elements up to twice the original element limit and removes them again.
+    // The callbacks receive the duration of each insert and remove in nanoseconds.
+    void benchmarkTileElements(const fs::path& path, bool headless, const std::function<void(uint64_t)>& onInsert, const std::function<void(uint64_t)>& onRemove);
+    // Loads the given file and computes the state hash the given number of times, the callback receives the duration of each in nanoseconds.
+    void benchmarkStateHash(const fs::path& path, bool headless, int32_t iterations, const std::function<void(uint64_t)>& onHash);
 
     void sub_431695(uint16_t var_F253A0);
     int main(std::vector<std::string>&& argv);
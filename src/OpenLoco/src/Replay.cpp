@@ -0,0 +1,193 @@
+#include "Replay.h"
+#include "Game.h"
+#include "GameState.h"
+#include "GameStateFlags.h"
+#include "Logging.h"
+#include "S5/S5.h"
+#include "ScenarioManager.h"
+#include "SceneManager.h"
+#include <OpenLoco/Core/FileStream.h>
+#include <OpenLoco/Core/MemoryStream.h>
+#include <optional>
+#include <stdexcept>
+
+using namespace OpenLoco::Diagnostics;
+
+namespace OpenLoco::Replay
+{
+#pragma pack(push, 1)
+    struct FileHeader
+    {
+        uint32_t magic;
+        uint16_t version;
+        uint16_t pad_06;
+        uint32_t startTick;
+        uint32_t endTick;
+        uint32_t saveLength;
+        uint32_t numCommands;
+        uint32_t numCheckpoints;
+    };
+#pragma pack(pop)
+    static_assert(sizeof(FileHeader) == 0x1C);
+
+    static std::optional<fs::path> _pendingPath;
+    static std::optional<fs::path> _recordingPath;
+    static std::unique_ptr<ReplayFile> _recording;
+    static bool _isInTick = false;
+
+    void requestRecording(const fs::path& path)
+    {
+        _pendingPath = path;
+    }
+
+    bool isRecording()
+    {
+        return _recording != nullptr;
+    }
+
+    static void startRecording()
+    {
+        // The save is only a snapshot, recording it does not modify the game state beyond
+        // what saving normally does (tile element reorganisation and spatial index reset).
+        MemoryStream ms;
+        if (!S5::exportGameStateToFile(ms, S5::SaveFlags::packCustomObjects | S5::SaveFlags::noWindowClose))
+        {
+            Logging::error("Unable to start replay recording, the game could not be saved");
+            _pendingPath = std::nullopt;
+            return;
+        }
+
+        _recording = std::make_unique<ReplayFile>();
+        _recording->startTick = ScenarioManager::getScenarioTicks();
+        _recording->save.assign(ms.data(), ms.data() + ms.getLength());
+        _recordingPath = _pendingPath;
+        _pendingPath = std::nullopt;
+
+        Logging::info("Started recording replay at tick {}", _recording->startTick);
+    }
+
+    void stopRecording()
+    {
+        if (_recording == nullptr)
+        {
+            return;
+        }
+
+        _recording->endTick = ScenarioManager::getScenarioTicks();
+        try
+        {
+            writeReplay(*_recordingPath, *_recording);
+            Logging::info("Replay of {} ticks written to {}", _recording->endTick - _recording->startTick, _recordingPath->u8string());
+        }
+        catch (const std::exception& e)
+        {
+            Logging::error("Unable to write replay: {}", e.what());
+        }
+
+        _recording = nullptr;
+        _recordingPath = std::nullopt;
+    }
+
+    // Called at the start of tickLogic before the tick is advanced
+    void beginTick()
+    {
+        _isInTick = true;
+
+        if (isTitleMode() || !Game::hasFlags(GameStateFlags::tileManagerLoaded))
+        {
+            // Returning to the title screen ends the game that was being recorded.
+            stopRecording();
+            return;
+        }
+
+        if (_pendingPath && !isRecording())
+        {
+            startRecording();
+        }
+    }
+
+    // Called at the end of tickLogic, player issued game commands follow after this.
+    void endTick()
+    {
+        _isInTick = false;
+
+        if (!isRecording())
+        {
+            return;
+        }
+
+        const auto tick = ScenarioManager::getScenarioTicks();
+        if ((tick - _recording->startTick) % kCheckpointInterval == 0)
+        {
+            _recording->checkpoints.push_back(createCheckpoint());
+        }
+    }
+
+    void recordGameCommand(CompanyId company, const Interop::registers& regs)
+    {
+        // Commands issued while the tick is running (e.g. by the AI) are reproduced by the simulation itself.
+        if (!isRecording() || _isInTick)
+        {
+            return;
+        }
+
+        _recording->commands.push_back(GameCommandRecord{ ScenarioManager::getScenarioTicks(), company, regs });
+    }
+
+    Checkpoint createCheckpoint()
+    {
+        auto& gameState = getGameState();
+
+        Checkpoint checkpoint{};
+        checkpoint.tick = ScenarioManager::getScenarioTicks();
+        checkpoint.srand0 = gameState.rng.srand_0();
+        checkpoint.srand1 = gameState.rng.srand_1();
+        checkpoint.state = StateHash::compute();
+        return checkpoint;
+    }
+
+    std::unique_ptr<ReplayFile> readReplay(const fs::path& path)
+    {
+        FileStream stream(path, StreamMode::read);
+
+        FileHeader header{};
+        stream.readValue(header);
+        if (header.magic != kReplayMagic)
+        {
+            throw std::runtime_error("Not a replay file");
+        }
+        if (header.version != kReplayVersion)
+        {
+            throw std::runtime_error("Unsupported replay version");
+        }
+
+        auto replay = std::make_unique<ReplayFile>();
+        replay->startTick = header.startTick;
+        replay->endTick = header.endTick;
+        replay->save.resize(header.saveLength);
+        stream.read(replay->save.data(), replay->save.size());
+        replay->commands.resize(header.numCommands);
+        stream.read(replay->commands.data(), replay->commands.size() * sizeof(GameCommandRecord));
+        replay->checkpoints.resize(header.numCheckpoints);
+        stream.read(replay->checkpoints.data(), replay->checkpoints.size() * sizeof(Checkpoint));
+        return replay;
+    }
+
+    void writeReplay(const fs::path& path, const ReplayFile& replay)
+    {
+        FileStream stream(path, StreamMode::write);
+
+        FileHeader header{};
+        header.magic = kReplayMagic;
+        header.version = kReplayVersion;
+        header.startTick = replay.startTick;
+        header.endTick = replay.endTick;
+        header.saveLength = static_cast<uint32_t>(replay.save.size());
+        header.numCommands = static_cast<uint32_t>(replay.commands.size());
+        header.numCheckpoints = static_cast<uint32_t>(replay.checkpoints.size());
+        stream.writeValue(header);
+        stream.write(replay.save.data(), replay.save.size());
+        stream.write(replay.commands.data(), replay.commands.size() * sizeof(GameCommandRecord));
+        stream.write(replay.checkpoints.data(), replay.checkpoints.size() * sizeof(Checkpoint));
+    }
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "StateHash.h"
+#include "Types.hpp"
+#include <OpenLoco/Core/FileSystem.hpp>
+#include <OpenLoco/Interop/Interop.hpp>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace OpenLoco::Replay
+{
+    // A replay is the saved game the recording started from plus every game command issued by
+    // a player, re-running it will produce the same game as long as the simulation is deterministic.
+    // Checkpoints of the rng and state digest are stored so divergence can be found when replaying.
+    constexpr uint32_t kReplayMagic = 0x50524C4F; // 'OLRP'
+    constexpr uint16_t kReplayVersion = 2;
+    constexpr uint32_t kCheckpointInterval = 100;
+
+#pragma pack(push, 1)
+    struct GameCommandRecord
+    {
+        uint32_t tick;
+        CompanyId company;
+        Interop::registers regs; // esi holds the game command
+    };
+    static_assert(sizeof(GameCommandRecord) == 0x21);
+
+    struct Checkpoint
+    {
+        uint32_t tick;
+        uint32_t srand0;
+        uint32_t srand1;
+        StateHash::Digest state;
+    };
+    static_assert(sizeof(Checkpoint) == 0x44);
+#pragma pack(pop)
+
+    struct ReplayFile
+    {
+        uint32_t startTick{};
+        uint32_t endTick{};
+        std::vector<std::byte> save;
+        std::vector<GameCommandRecord> commands;
+        std::vector<Checkpoint> checkpoints;
+    };
+
+    // Recording starts at the beginning of the next tick of a loaded game.
+    void requestRecording(const fs::path& path);
+    void stopRecording();
+    bool isRecording();
+
+    void beginTick();
+    void endTick();
+    void recordGameCommand(CompanyId company, const Interop::registers& regs);
+
+    Checkpoint createCheckpoint();
+
+    std::unique_ptr<ReplayFile> readReplay(const fs::path& path);
+    void writeReplay(const fs::path& path, const ReplayFile& replay);
+}
@@ -13,6 +13,7 @@
 #include "Localisation/StringIds.h"
 #include "Localisation/StringManager.h"
 #include "Map/TileManager.h"
+#include "Map/Track/Track.h"
 #include "Objects/ObjectIndex.h"
 #include "Objects/ObjectManager.h"
 #include "OpenLoco.h"
@@ -21,6 +22,7 @@
 #include "SceneManager.h"
 #include "Ui/WindowManager.h"
 #include "Vehicles/OrderManager.h"
+#include "Vehicles/Vehicle.h"
 #include "ViewportManager.h"
 #include "World/CompanyManager.h"
 #include "World/IndustryManager.h"
@@ -101,6 +103,12 @@ namespace OpenLoco::S5
         {
             result.flags |= HeaderFlags::hasSaveDetails;
         }
+        if (!hasSaveFlags(flags, SaveFlags::raw)
+            && !hasSaveFlags(flags, SaveFlags::dump)
+            && EntityManager::getMiscEntityLimit() != Limits::kMaxMiscEntities)
+        {
+            result.flags |= HeaderFlags::hasEntityLimits;
+        }
 
         return result;
     }
@@ -237,10 +245,30 @@ namespace OpenLoco::S5
         file->gameState.savedViewRotation = savedView.rotation;
         file->gameState.magicNumber = kMagicNumber; // Match implementation at 0x004437FC
 
-        auto tileElements = TileManager::getElements();
-        file->tileElements.resize(tileElements.size());
-        std::memcpy(file->tileElements.data(), tileElements.data(), tileElements.size_bytes());
+        // Copied tile by tile so the buffer does not have to be reorganised first.
+        file->tileElements.clear();
+        file->tileElements.reserve(TileManager::getElementCapacity() - TileManager::numFreeElements());
+        for (tile_coord_t y = 0; y < kMapRows; y++)
+        {
+            for (tile_coord_t x = 0; x < kMapColumns; x++)
+            {
+                for (const auto& element : TileManager::get(TilePos2(x, y)))
+                {
+                    file->tileElements.push_back(reinterpret_cast<const TileElement&>(element));
+                }
+            }
+        }
         removeGhostElements(file->tileElements);
+        if (file->tileElements.size() > TileManager::maxElements)
+        {
+            file->header.flags |= HeaderFlags::hasExtendedTileElements;
+        }
+
+        if (file->header.hasFlags(HeaderFlags::hasEntityLimits))
+        {
+            file->entityLimits = std::make_unique<EntityLimits>();
+            file->entityLimits->maxMiscEntities = EntityManager::getMiscEntityLimit();
+        }
         return file;
     }
 
@@ -259,7 +287,9 @@ namespace OpenLoco::S5
         return exportGameStateToFile(fs, flags);
     }
 
-    bool exportGameStateToFile(Stream& stream, SaveFlags flags)
+    // Tidies up the game state and copies everything that is saved, must be called from the game thread.
+    // A snapshot leaves the element buffer as it is, the elements are copied in tile order either way.
+    static std::unique_ptr<S5File> prepareSave(SaveFlags flags, std::vector<ObjectHeader>& packedObjects, bool isSnapshot = false)
     {
         if ((flags & SaveFlags::noWindowClose) == SaveFlags::none
             && (flags & SaveFlags::raw) == SaveFlags::none
@@ -270,28 +300,29 @@ namespace OpenLoco::S5
 
         if ((flags & SaveFlags::raw) == SaveFlags::none)
         {
-            TileManager::reorganise();
+            if (!isSnapshot)
+            {
+                TileManager::reorganise();
+            }
             EntityManager::resetSpatialIndex();
             EntityManager::zeroUnused();
             StationManager::zeroUnused();
             Vehicles::OrderManager::zeroOrderTable();
         }
 
-        bool saveResult;
+        auto requiredObjects = ObjectManager::getHeaders();
+        if (shouldPackObjects(flags))
         {
-            auto requiredObjects = ObjectManager::getHeaders();
-            std::vector<ObjectHeader> packedObjects;
-            if (shouldPackObjects(flags))
-            {
-                std::copy_if(requiredObjects.begin(), requiredObjects.end(), std::back_inserter(packedObjects), [](ObjectHeader& header) {
-                    return !header.isEmpty() && !header.isVanilla();
-                });
-            }
-
-            auto file = prepareGameState(flags, requiredObjects, packedObjects);
-            saveResult = exportGameState(stream, *file, packedObjects);
+            std::copy_if(requiredObjects.begin(), requiredObjects.end(), std::back_inserter(packedObjects), [](ObjectHeader& header) {
+                return !header.isEmpty() && !header.isVanilla();
+            });
         }
 
+        return prepareGameState(flags, requiredObjects, packedObjects);
+    }
+
+    static bool finishSave(SaveFlags flags, bool saveResult)
+    {
         if ((flags & SaveFlags::raw) == SaveFlags::none
             && (flags & SaveFlags::dump) == SaveFlags::none)
         {
@@ -312,47 +343,76 @@ namespace OpenLoco::S5
         return false;
     }
 
-    static bool exportGameState(Stream& stream, const S5File& file, const std::vector<ObjectHeader>& packedObjects)
+    bool exportGameStateToFile(Stream& stream, SaveFlags flags)
     {
-        try
+        std::vector<ObjectHeader> packedObjects;
+        auto file = prepareSave(flags, packedObjects);
+        const auto saveResult = exportGameState(stream, *file, packedObjects);
+        return finishSave(flags, saveResult);
+    }
+
+    std::unique_ptr<S5File> createSnapshot(SaveFlags flags)
+    {
+        // Packing objects needs the object manager, which is only safe to use from the game thread.
+        flags &= ~SaveFlags::packCustomObjects;
+
+        // Nothing is unloaded while copying so, unlike a normal save, the objects do not need reloading.
+        std::vector<ObjectHeader> packedObjects;
+        return prepareSave(flags, packedObjects, true);
+    }
+
+    // Throws on failure and does not log so that it can be used from any thread.
+    static void writeGameState(Stream& stream, const S5File& file, const std::vector<ObjectHeader>& packedObjects)
+    {
+        SawyerStreamWriter fs(stream);
+        fs.writeChunk(SawyerEncoding::rotate, file.header);
+        if (file.header.type == S5Type::scenario || file.header.type == S5Type::landscape)
         {
-            SawyerStreamWriter fs(stream);
-            fs.writeChunk(SawyerEncoding::rotate, file.header);
-            if (file.header.type == S5Type::scenario || file.header.type == S5Type::landscape)
-            {
-                fs.writeChunk(SawyerEncoding::rotate, *file.landscapeOptions);
-            }
-            if (file.header.hasFlags(HeaderFlags::hasSaveDetails))
-            {
-                fs.writeChunk(SawyerEncoding::rotate, *file.saveDetails);
-            }
-            if (file.header.numPackedObjects != 0)
-            {
-                ObjectManager::writePackedObjects(fs, packedObjects);
-            }
-            fs.writeChunk(SawyerEncoding::rotate, file.requiredObjects, sizeof(file.requiredObjects));
+            fs.writeChunk(SawyerEncoding::rotate, *file.landscapeOptions);
+        }
+        if (file.header.hasFlags(HeaderFlags::hasSaveDetails))
+        {
+            fs.writeChunk(SawyerEncoding::rotate, *file.saveDetails);
+        }
+        if (file.header.numPackedObjects != 0)
+        {
+            ObjectManager::writePackedObjects(fs, packedObjects);
+        }
+        fs.writeChunk(SawyerEncoding::rotate, file.requiredObjects, sizeof(file.requiredObjects));
 
-            if (file.header.type == S5Type::scenario)
-            {
-                fs.writeChunk(SawyerEncoding::runLengthSingle, file.gameState.rng, 0xB96C);
-                fs.writeChunk(SawyerEncoding::runLengthSingle, file.gameState.towns, 0x123480);
-                fs.writeChunk(SawyerEncoding::runLengthSingle, file.gameState.animations, 0x79D80);
-            }
-            else
-            {
-                fs.writeChunk(SawyerEncoding::runLengthSingle, file.gameState);
-            }
+        if (file.header.type == S5Type::scenario)
+        {
+            fs.writeChunk(SawyerEncoding::runLengthSingle, file.gameState.rng, 0xB96C);
+            fs.writeChunk(SawyerEncoding::runLengthSingle, file.gameState.towns, 0x123480);
+            fs.writeChunk(SawyerEncoding::runLengthSingle, file.gameState.animations, 0x79D80);
+        }
+        else
+        {
+            fs.writeChunk(SawyerEncoding::runLengthSingle, file.gameState);
+        }
 
-            if (file.header.hasFlags(HeaderFlags::isRaw))
-            {
-                throw NotImplementedException();
-            }
-            else
-            {
-                fs.writeChunk(SawyerEncoding::runLengthMulti, file.tileElements.data(), file.tileElements.size() * sizeof(TileElement));
-            }
+        if (file.header.hasFlags(HeaderFlags::isRaw))
+        {
+            throw NotImplementedException();
+        }
+        else
+        {
+            fs.writeChunk(SawyerEncoding::runLengthMulti, file.tileElements.data(), file.tileElements.size() * sizeof(TileElement));
+        }
 
-            fs.writeChecksum();
+        if (file.header.hasFlags(HeaderFlags::hasEntityLimits))
+        {
+            fs.writeChunk(SawyerEncoding::rotate, *file.entityLimits);
+        }
+
+        fs.writeChecksum();
+    }
+
+    static bool exportGameState(Stream& stream, const S5File& file, const std::vector<ObjectHeader>& packedObjects)
+    {
+        try
+        {
+            writeGameState(stream, file, packedObjects);
             return true;
         }
         catch (const std::exception& e)
@@ -362,6 +422,11 @@ namespace OpenLoco::S5
         }
     }
 
+    void writeSnapshot(Stream& stream, const S5File& file)
+    {
+        writeGameState(stream, file, {});
+    }
+
     // 0x00445A4A
     static void fixState(GameState& state)
     {
@@ -481,6 +546,12 @@ namespace OpenLoco::S5
             std::memcpy(file->tileElements.data(), tileElements.data(), numTileElements * sizeof(TileElement));
         }
 
+        if (file->header.hasFlags(HeaderFlags::hasEntityLimits))
+        {
+            file->entityLimits = std::make_unique<EntityLimits>();
+            fs.readChunk(file->entityLimits.get(), sizeof(EntityLimits));
+        }
+
         return file;
     }
 
@@ -625,6 +696,12 @@ namespace OpenLoco::S5
                 throw LoadException("Unsupported S5 format", StringIds::error_file_contains_invalid_data);
             }
 
+            const auto maxTileElements = file->header.hasFlags(HeaderFlags::hasExtendedTileElements) ? TileManager::kMaxGrownElements : TileManager::maxElements;
+            if (file->tileElements.size() > maxTileElements)
+            {
+                throw LoadException("Too many tile elements", StringIds::error_file_contains_invalid_data);
+            }
+
             if (hasLoadFlags(flags, LoadFlags::twoPlayer))
             {
                 if (file->header.type != S5Type::landscape)
@@ -661,6 +738,13 @@ namespace OpenLoco::S5
             ObjectManager::reloadAll();
 
             _gameState = file->gameState;
+            // Lookups cached by the managers may coincidentally be for the same tick as the loaded game.
+            StationManager::invalidateCoverage();
+            StationManager::invalidateOccupancy();
+            IndustryManager::invalidateOccupancy();
+            TownManager::invalidateOccupancy();
+            Vehicles::invalidateSignalBlocks();
+            World::Track::invalidateConnections();
             if (hasLoadFlags(flags, LoadFlags::scenario))
             {
                 _activeOptions = *file->landscapeOptions;
@@ -679,6 +763,14 @@ namespace OpenLoco::S5
                 CompanyManager::reset();
                 EntityManager::reset();
             }
+            if (file->entityLimits != nullptr)
+            {
+                EntityManager::setMiscEntityLimit(file->entityLimits->maxMiscEntities);
+            }
+            else if (!hasLoadFlags(flags, LoadFlags::scenario))
+            {
+                EntityManager::setMiscEntityLimit(Limits::kMaxMiscEntities);
+            }
 
             EntityManager::resetSpatialIndex();
             CompanyManager::updateColours();
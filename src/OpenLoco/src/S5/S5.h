@@ -34,6 +34,8 @@ namespace OpenLoco::S5
         isDump = 1U << 1,
         isTitleSequence = 1U << 2,
         hasSaveDetails = 1U << 3,
+        hasEntityLimits = 1U << 4,
+        hasExtendedTileElements = 1U << 5, // More tile elements than the original game can hold
     };
     OPENLOCO_ENABLE_ENUM_OPERATORS(HeaderFlags);
 
@@ -54,6 +56,17 @@ namespace OpenLoco::S5
 #pragma pack(pop)
     static_assert(sizeof(Header) == 0x20);
 
+    // Extension chunk written after the tile elements, only present when the limits differ from vanilla
+    // so that the original game can still load saves that use the default limits.
+#pragma pack(push, 1)
+    struct EntityLimits
+    {
+        uint16_t maxMiscEntities;
+        std::byte padding[14];
+    };
+#pragma pack(pop)
+    static_assert(sizeof(EntityLimits) == 0x10);
+
     enum class TopographyStyle : uint8_t
     {
         flatLand,
@@ -421,6 +434,7 @@ namespace OpenLoco::S5
         ObjectHeader requiredObjects[859];
         GameState gameState;
         std::vector<TileElement> tileElements;
+        std::unique_ptr<EntityLimits> entityLimits;
         std::vector<std::pair<ObjectHeader, std::vector<std::byte>>> packedObjects;
     };
 
@@ -454,6 +468,12 @@ namespace OpenLoco::S5
     Options& getOptions();
     bool exportGameStateToFile(const fs::path& path, SaveFlags flags);
     bool exportGameStateToFile(Stream& stream, SaveFlags flags);
+
+    // Saving split in two, createSnapshot copies the game state on the game thread, writeSnapshot does the
+    // encoding and writing, throws on failure instead of logging and is safe to call from any thread. The copy
+    // still walks every tile and draws the preview image so it is not free. Custom objects are never packed.
+    std::unique_ptr<S5File> createSnapshot(SaveFlags flags);
+    void writeSnapshot(Stream& stream, const S5File& file);
     void registerHooks();
 
     const std::vector<ObjectHeader>& getObjectErrorList();
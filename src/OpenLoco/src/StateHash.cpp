@@ -0,0 +1,175 @@
+#include "StateHash.h"
+#include "GameState.h"
+#include "Map/TileManager.h"
+#include <OpenLoco/Engine/World.hpp>
+#include <OpenLoco/Core/Hash.h>
+#include <OpenLoco/Core/Span.hpp>
+#include <iterator>
+
+namespace OpenLoco::StateHash
+{
+    // Hashes consecutive runs of used objects in one go, which is much faster than hashing them one by one.
+    template<typename T, typename TPred>
+    static uint64_t hashUsed(stdx::span<const T> objects, TPred&& isUsed)
+    {
+        uint64_t hash = 0;
+        size_t runStart = 0;
+        for (size_t i = 0; i <= objects.size(); i++)
+        {
+            if (i < objects.size() && isUsed(objects[i]))
+            {
+                continue;
+            }
+            if (i != runStart)
+            {
+                // Mix in where the run starts, otherwise objects moving between slots would go unnoticed.
+                hash = Core::hashValue(static_cast<uint32_t>(runStart), hash);
+                hash = Core::hash64(&objects[runStart], (i - runStart) * sizeof(T), hash);
+            }
+            runStart = i + 1;
+        }
+        return hash;
+    }
+
+    template<typename T, size_t TSize>
+    static uint64_t hashUsed(const T (&objects)[TSize])
+    {
+        return hashUsed(stdx::span<const T>(objects, TSize), [](const T& object) { return !object.empty(); });
+    }
+
+    static uint64_t hashRange(const void* begin, const void* end, uint64_t seed)
+    {
+        const auto* b = static_cast<const std::byte*>(begin);
+        const auto* e = static_cast<const std::byte*>(end);
+        return Core::hash64(b, e - b, seed);
+    }
+
+    // Hashes a tile that has ghost elements as if they were not there, the last flag is moved to the final kept element.
+    static void hashTileWithoutGhosts(Core::Hasher64& hasher, const World::Tile& tile)
+    {
+        const World::TileElement* pending = nullptr;
+        for (const auto& el : tile)
+        {
+            if (el.isGhost())
+            {
+                continue;
+            }
+            if (pending != nullptr)
+            {
+                auto copy = *pending;
+                copy.setLastFlag(false);
+                hasher.updateValue(copy);
+            }
+            pending = &el;
+        }
+        auto copy = pending != nullptr ? *pending : World::TileElement{};
+        copy.setLastFlag(true);
+        hasher.updateValue(copy);
+    }
+
+    // The element buffer differs between games with the same state: ghosts are only placed locally and
+    // saving or defragmenting reorders it. The tiles are therefore hashed in map order without ghosts.
+    // Nothing is copied for tiles without ghosts, and tiles that follow each other in the buffer as well
+    // as on the map are hashed as a single run, which after loading or defragmenting is most of the map.
+    static uint64_t hashTiles()
+    {
+        Core::Hasher64 hasher;
+        const World::TileElement* runStart = nullptr;
+        const World::TileElement* runEnd = nullptr;
+        const auto hashRun = [&]() {
+            if (runStart != runEnd)
+            {
+                hasher.update(runStart, (runEnd - runStart) * sizeof(World::TileElement));
+            }
+            runStart = runEnd = nullptr;
+        };
+
+        for (tile_coord_t y = 0; y < World::kMapRows; y++)
+        {
+            for (tile_coord_t x = 0; x < World::kMapColumns; x++)
+            {
+                const auto tile = World::TileManager::get(World::TilePos2(x, y));
+                const World::TileElement* begin = tile.begin();
+                const World::TileElement* end = begin;
+                bool hasGhost = false;
+                do
+                {
+                    hasGhost |= end->isGhost();
+                } while (!(end++)->isLast());
+
+                if (hasGhost)
+                {
+                    hashRun();
+                    hashTileWithoutGhosts(hasher, tile);
+                    continue;
+                }
+                if (begin != runEnd)
+                {
+                    hashRun();
+                    runStart = begin;
+                }
+                runEnd = end;
+            }
+        }
+        hashRun();
+        return hasher.digest();
+    }
+
+    Digest compute()
+    {
+        const auto& gameState = getGameState();
+
+        Digest digest{};
+        digest.general = hashRange(&gameState, &gameState.companies, 0);
+        digest.general = hashRange(&gameState.animations, &gameState + 1, digest.general);
+        digest.companies = hashUsed(gameState.companies);
+        digest.towns = hashUsed(gameState.towns);
+        digest.industries = hashUsed(gameState.industries);
+        digest.stations = hashUsed(gameState.stations);
+        digest.entities = hashUsed(stdx::span<const Entity>(gameState.entities, std::size(gameState.entities)), [](const Entity& entity) {
+            return entity.baseType != EntityBaseType::null;
+        });
+
+        digest.tiles = hashTiles();
+        return digest;
+    }
+
+    uint64_t Digest::combined() const
+    {
+        return Core::hashValue(*this);
+    }
+
+    bool Digest::operator==(const Digest& rhs) const
+    {
+        return general == rhs.general
+            && companies == rhs.companies
+            && towns == rhs.towns
+            && industries == rhs.industries
+            && stations == rhs.stations
+            && entities == rhs.entities
+            && tiles == rhs.tiles;
+    }
+
+    std::string getMismatchedSubsystems(const Digest& a, const Digest& b)
+    {
+        std::string result;
+        const auto check = [&result](const char* name, uint64_t lhs, uint64_t rhs) {
+            if (lhs != rhs)
+            {
+                if (!result.empty())
+                {
+                    result += ", ";
+                }
+                result += name;
+            }
+        };
+        check("general", a.general, b.general);
+        check("companies", a.companies, b.companies);
+        check("towns", a.towns, b.towns);
+        check("industries", a.industries, b.industries);
+        check("stations", a.stations, b.stations);
+        check("entities", a.entities, b.entities);
+        check("tiles", a.tiles, b.tiles);
+        return result;
+    }
+}
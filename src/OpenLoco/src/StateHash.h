@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace OpenLoco::StateHash
+{
+    // Digest of the simulation state, split per subsystem so that a mismatch between two
+    // games can be narrowed down. Only live objects are hashed, but the tiles are walked over
+    // the whole map so avoid computing it more often than once per tick.
+#pragma pack(push, 1)
+    struct Digest
+    {
+        uint64_t general; // Everything in the game state not covered by one of the others
+        uint64_t companies;
+        uint64_t towns;
+        uint64_t industries;
+        uint64_t stations;
+        uint64_t entities;
+        uint64_t tiles;
+
+        uint64_t combined() const;
+
+        bool operator==(const Digest& rhs) const;
+        bool operator!=(const Digest& rhs) const { return !(*this == rhs); }
+    };
+#pragma pack(pop)
+    static_assert(sizeof(Digest) == 0x38);
+
+    Digest compute();
+
+    // Comma separated names of the subsystems that differ, for logging.
+    std::string getMismatchedSubsystems(const Digest& a, const Digest& b);
+}
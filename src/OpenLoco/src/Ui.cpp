@@ -46,6 +46,7 @@
 #include "Ui/WindowManager.h"
 #include "Window.h"
 #include "World/CompanyManager.h"
+#include <OpenLoco/Diagnostics/Profiling.h>
 #include <OpenLoco/Interop/Interop.hpp>
 #include <OpenLoco/Utility/String.hpp>
 
@@ -374,6 +375,8 @@ namespace OpenLoco::Ui
 
     void render()
     {
+        OPENLOCO_PROFILE_SCOPE("Ui::render");
+
         if (window == nullptr)
             return;
 
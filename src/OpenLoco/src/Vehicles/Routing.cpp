@@ -11,6 +11,10 @@
 #include "ViewportManager.h"
 #include <OpenLoco/Engine/World.hpp>
 #include <OpenLoco/Interop/Interop.hpp>
+#include <chrono>
+#include <functional>
+#include <unordered_map>
+#include <vector>
 
 namespace OpenLoco::Vehicles
 {
@@ -24,12 +28,12 @@ namespace OpenLoco::Vehicles
         CompanyId company;
         uint8_t trackType;
 
-        bool operator==(const LocationOfInterest& rhs)
+        bool operator==(const LocationOfInterest& rhs) const
         {
             return (loc == rhs.loc) && (trackAndDirection == rhs.trackAndDirection) && (company == rhs.company) && (trackType == rhs.trackType);
         }
 
-        bool operator!=(const LocationOfInterest& rhs)
+        bool operator!=(const LocationOfInterest& rhs) const
         {
             return !(*this == rhs);
         }
@@ -40,143 +44,119 @@ namespace OpenLoco::Vehicles
         }
     };
 
-    struct LocationOfInterestHashMap
+    // Open addressing set of the locations found by a search. The original had a fixed 0x400 slots
+    // and stopped adding after 0x39C entries, this grows instead. Slots hold an index into the entries,
+    // so iterating is in the order of insertion, and the generation they were written in so clearing
+    // does not need to touch them.
+    class LocationOfInterestHashMap
     {
-        static constexpr auto kMapSize = 0x400;
-        static constexpr auto kMapSizeMask = kMapSize - 1;
-        static constexpr auto kMaxEntries = 0x39C;
+        static constexpr uint32_t kMinSlots = 0x400;
 
-    private:
-#pragma pack(push, 1)
-        struct ZAndTD
+        struct Slot
         {
-            coord_t z;
-            uint16_t trackAndDirection;
+            uint32_t generation;
+            uint32_t index;
         };
-        struct CAndT
-        {
-            CompanyId company;
-            uint8_t trackType;
-            uint8_t pad[0x2];
-        };
-#pragma pack(pop)
 
-        class Iterator
+        std::vector<Slot> _slots;
+        std::vector<LocationOfInterest> _entries;
+        uint32_t _generation = 1;
+
+        static uint64_t hash(const LocationOfInterest& interest)
         {
-            uint16_t _index;
-            const LocationOfInterestHashMap& _map;
+            uint64_t h = (static_cast<uint64_t>(static_cast<uint16_t>(interest.loc.x)) << 48)
+                | (static_cast<uint64_t>(static_cast<uint16_t>(interest.loc.y)) << 32)
+                | (static_cast<uint64_t>(static_cast<uint16_t>(interest.loc.z)) << 16)
+                | interest.trackAndDirection;
+            h ^= (static_cast<uint64_t>(enumValue(interest.company)) << 8 | interest.trackType) * 0x9E3779B97F4A7C15ULL;
 
-        public:
-            Iterator(uint16_t index, const LocationOfInterestHashMap& map)
-                : _index(index)
-                , _map(map)
-            {
-                findAllocatedEntry();
-            }
+            // splitmix64 finaliser
+            h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            h = (h ^ (h >> 27)) * 0x94D049BB133111EBULL;
+            return h ^ (h >> 31);
+        }
 
-            void findAllocatedEntry()
+        // Returns the slot holding the interest or the empty slot it would go in.
+        Slot& findSlot(const LocationOfInterest& interest)
+        {
+            const auto mask = _slots.size() - 1;
+            for (auto index = hash(interest) & mask;; index = (index + 1) & mask)
             {
-                while (_index < kMapSize && _map.locs[_index] == World::Pos2{ -1, -1 })
+                auto& slot = _slots[index];
+                if (slot.generation != _generation || _entries[slot.index] == interest)
                 {
-                    _index++;
+                    return slot;
                 }
             }
+        }
 
-            Iterator& operator++()
+        void grow()
+        {
+            _slots.assign(_slots.size() * 2, Slot{});
+            _generation = 1;
+            for (uint32_t i = 0; i < _entries.size(); ++i)
             {
-                _index++;
-                findAllocatedEntry();
-                return *this;
+                findSlot(_entries[i]) = Slot{ _generation, i };
             }
+        }
 
-            Iterator operator++(int)
-            {
-                Iterator retval = *this;
-                ++(*this);
-                return retval;
-            }
+    public:
+        LocationOfInterestHashMap()
+            : _slots(kMinSlots)
+        {
+        }
 
-            bool operator==(Iterator& other) const
-            {
-                return _index == other._index;
-            }
-            bool operator!=(Iterator& other) const
+        // 0x004A38DE
+        bool tryAdd(const LocationOfInterest& interest)
+        {
+            // Kept at most half full so probe sequences stay short.
+            if ((_entries.size() + 1) * 2 > _slots.size())
             {
-                return !(*this == other);
+                grow();
             }
 
-            LocationOfInterest operator*() const
+            auto& slot = findSlot(interest);
+            if (slot.generation == _generation)
             {
-                return _map.get(_index);
+                return false;
             }
-            // iterator traits
-            using difference_type = std::ptrdiff_t;
-            using value_type = LocationOfInterest;
-            using pointer = LocationOfInterest*;
-            using reference = LocationOfInterest&;
-            using iterator_category = std::forward_iterator_tag;
-        };
-
-    public:
-#pragma pack(push, 1)
-        World::Pos2 locs[kMapSize];
-        ZAndTD zAndTDs[kMapSize];
-        CAndT cAndTs[kMapSize];
-#pragma pack(pop)
-        size_t count; // count does not need to be tightly packed as this is only accessed via a pointer to first 3 members
-
-        LocationOfInterestHashMap()
-            : zAndTDs{}
-            , cAndTs{}
-            , count()
-        {
-            std::fill(std::begin(locs), std::end(locs), World::Pos2{ -1, -1 });
+            slot = Slot{ _generation, static_cast<uint32_t>(_entries.size()) };
+            _entries.push_back(interest);
+            return true;
         }
 
-        LocationOfInterest get(const uint16_t index) const
+        bool contains(const LocationOfInterest& interest)
         {
-            return LocationOfInterest{ World::Pos3(locs[index].x, locs[index].y, zAndTDs[index].z), zAndTDs[index].trackAndDirection, cAndTs[index].company, cAndTs[index].trackType };
+            return findSlot(interest).generation == _generation;
         }
 
-        constexpr uint16_t hash(const LocationOfInterest& interest) const
+        void clear()
         {
-            return ((((interest.loc.x ^ interest.loc.z) / 32) ^ interest.loc.y) ^ interest.trackAndDirection) & kMapSizeMask;
+            _entries.clear();
+            if (++_generation == 0)
+            {
+                // Slots of a previous wrap around could look current again.
+                std::fill(_slots.begin(), _slots.end(), Slot{});
+                _generation = 1;
+            }
         }
 
-        // 0x004A38DE
-        bool tryAdd(LocationOfInterest& interest)
+        size_t size() const
         {
-            auto index = hash(interest);
-            for (; locs[index] != World::Pos2{ -1, -1 }; ++index, index &= kMapSizeMask)
-            {
-                if (get(index) == interest)
-                {
-                    return false;
-                }
-            }
-            if (count >= kMaxEntries)
-            {
-                return false;
-            }
-            locs[index] = interest.loc;
-            zAndTDs[index] = ZAndTD{ interest.loc.z, interest.trackAndDirection };
-            cAndTs[index] = CAndT{ interest.company, interest.trackType, {} };
-            count++;
-            return true;
+            return _entries.size();
         }
 
-        Iterator begin() const
+        auto begin() const
         {
-            return Iterator(0, *this);
+            return _entries.begin();
         }
-        Iterator end() const
+        auto end() const
         {
-            return Iterator(kMapSize, *this);
+            return _entries.end();
         }
     };
 
     using FilterFunction = bool (*)(const LocationOfInterest& interest);
-    using TransformFunction = void (*)(const LocationOfInterestHashMap& hashMap);
 
     // Reverse direction map?
     static loco_global<uint8_t[16], 0x00503CAC> _503CAC;
@@ -184,9 +164,7 @@ namespace OpenLoco::Vehicles
     static loco_global<FilterFunction, 0x01135F0E> _filterFunction;
     static loco_global<uint32_t, 0x01135F0A> _1135F0A;
     static loco_global<uint16_t, 0x01135FA6> _1135FA6;
-    static loco_global<TransformFunction, 0x01135F12> _transformFunction;
     static loco_global<uint8_t, 0x01136085> _1136085;
-    static loco_global<LocationOfInterestHashMap*, 0x01135F06> _1135F06;
     static loco_global<uint8_t[2], 0x0113601A> _113601A;
     static loco_global<uint16_t, 0x001135F88> _routingTransformData;
 
@@ -437,40 +415,39 @@ namespace OpenLoco::Vehicles
             const auto rotPos = Math::Vector::rotate(Pos2{ trackPiece.x, trackPiece.y }, tad.cardinalDirection());
             const auto trackLoc = Pos2{ startLoc } + rotPos;
 
-            for (auto* entity : EntityManager::EntityTileList(trackLoc))
-            {
-                auto* vehicle = entity->asBase<Vehicles::VehicleBase>();
+            const auto tileStart = World::toWorldSpace(World::toTileSpace(trackLoc));
+            EntityManager::forEachEntityInRect(tileStart, tileStart + Pos2(kTileSize - 1, kTileSize - 1), [&](EntityBase& entity) {
+                auto* vehicle = entity.asBase<Vehicles::VehicleBase>();
                 if (vehicle == nullptr)
                 {
-                    continue;
+                    return;
                 }
 
                 if (vehicle->has38Flags(Vehicles::Flags38::unk_0 | Vehicles::Flags38::unk_2))
                 {
-                    continue;
+                    return;
                 }
 
                 if (vehicle->getTrackLoc() == interest.loc && vehicle->getTrackAndDirection().track == tad)
                 {
                     _routingTransformData = 1;
-                    break;
+                    return;
                 }
 
                 if (vehicle->getTrackLoc() == nextLoc && vehicle->getTrackAndDirection().track == backwardTaD)
                 {
                     _routingTransformData = 1;
-                    break;
                 }
-            }
+            });
         }
         return interest.trackAndDirection & (1 << 15);
     }
 
     // 0x004A2CE7
     // Passes occupied state via _routingTransformData
-    static void setSignalsOccupiedState(const LocationOfInterestHashMap& hashMap)
+    static void setSignalsOccupiedState(const std::vector<LocationOfInterest>& interests)
     {
-        for (const auto& interest : hashMap)
+        for (const auto& interest : interests)
         {
             if (!(interest.trackAndDirection & (1 << 15)))
             {
@@ -502,18 +479,15 @@ namespace OpenLoco::Vehicles
         return true;
     }
 
-    static void findAllUsableTrackInBlock(const LocationOfInterest& initialInterest, const FilterFunction filterFunction, LocationOfInterestHashMap& hashMap);
+    static bool isSignal(const LocationOfInterest& interest)
+    {
+        return interest.trackAndDirection & (1 << 15);
+    }
 
     // 0x004A313B
     // Iterates all individual tiles of a track piece to find tracks that need inspection
-    static void findAllUsableTrackPieces(const LocationOfInterest& interest, const FilterFunction filterFunction, LocationOfInterestHashMap& hashMap)
+    static void scanTrackPieces(const LocationOfInterest& interest, const FilterFunction filterFunction, LocationOfInterestHashMap& hashMap, std::vector<LocationOfInterest>& trackToCheck)
     {
-        if (!(_1135FA6 & (1 << 2)))
-        {
-            findAllUsableTrackInBlock(interest, filterFunction, hashMap);
-            return;
-        }
-
         const auto tad = interest.tad();
         auto nextLoc = interest.loc;
         if (tad.isReversed())
@@ -526,8 +500,6 @@ namespace OpenLoco::Vehicles
             }
         }
 
-        std::vector<LocationOfInterest> trackToCheck;
-
         for (auto& piece : World::TrackData::getTrackPiece(tad.id()))
         {
             const auto connectFlags = piece.connectFlags[tad.cardinalDirection()];
@@ -599,23 +571,15 @@ namespace OpenLoco::Vehicles
                 }
             }
         }
-
-        findAllUsableTrackInBlock(interest, filterFunction, hashMap);
-
-        for (auto& interest2 : trackToCheck)
-        {
-            findAllUsableTrackPieces(interest2, filterFunction, hashMap);
-        }
     }
 
     // 0x004A2FE6
-    static void findAllUsableTrackInBlock(const LocationOfInterest& initialInterest, const FilterFunction filterFunction, LocationOfInterestHashMap& hashMap)
+    static void scanTrackInBlock(const LocationOfInterest& initialInterest, const FilterFunction filterFunction, LocationOfInterestHashMap& hashMap, std::vector<LocationOfInterest>& trackToCheck)
     {
         World::Track::TrackConnections connections{};
         _113601A[0] = 0;
         _113601A[1] = 0;
         connections.size = 0;
-        std::vector<LocationOfInterest> trackToCheck;
 
         const auto [trackEndLoc, trackEndRotation] = World::Track::getTrackConnectionEnd(initialInterest.loc, initialInterest.tad()._data);
         World::Track::getTrackConnections(trackEndLoc, trackEndRotation, connections, initialInterest.company, initialInterest.trackType);
@@ -667,41 +631,220 @@ namespace OpenLoco::Vehicles
                 }
             }
         }
+    }
+
+    // The original recursed into 0x004A313B for each track found by either scan, which on big networks
+    // gets deep. This visits them in the same order using an explicit stack, the scratch storage is
+    // kept between calls so that once grown it is not allocated again.
+    struct TrackSearchFrame
+    {
+        LocationOfInterest interest;
+        uint32_t begin;      // Start of the pending track found by this frame
+        uint32_t end;        // End of the pending track found by this frame
+        uint32_t next;       // Index into the pending track of the next one to visit
+        bool isBlockPending; // A track pieces scan still has to scan the block of its track
+    };
+
+    static std::vector<TrackSearchFrame> _searchFrames;
+    static std::vector<LocationOfInterest> _searchPending;
+
+    static void pushTrackInBlock(const LocationOfInterest& interest, const FilterFunction filterFunction, LocationOfInterestHashMap& hashMap)
+    {
+        const auto begin = static_cast<uint32_t>(_searchPending.size());
+        scanTrackInBlock(interest, filterFunction, hashMap, _searchPending);
+        const auto end = static_cast<uint32_t>(_searchPending.size());
+        _searchFrames.push_back(TrackSearchFrame{ interest, begin, end, begin, false });
+    }
+
+    static void pushTrackPieces(const LocationOfInterest& interest, const FilterFunction filterFunction, LocationOfInterestHashMap& hashMap)
+    {
+        if (!(_1135FA6 & (1 << 2)))
+        {
+            pushTrackInBlock(interest, filterFunction, hashMap);
+            return;
+        }
+
+        const auto begin = static_cast<uint32_t>(_searchPending.size());
+        scanTrackPieces(interest, filterFunction, hashMap, _searchPending);
+        const auto end = static_cast<uint32_t>(_searchPending.size());
+        _searchFrames.push_back(TrackSearchFrame{ interest, begin, end, begin, true });
+    }
 
-        for (auto& interest : trackToCheck)
+    static void findAllUsableTrackInBlock(const LocationOfInterest& initialInterest, const FilterFunction filterFunction, LocationOfInterestHashMap& hashMap)
+    {
+        _searchFrames.clear();
+        _searchPending.clear();
+        pushTrackInBlock(initialInterest, filterFunction, hashMap);
+
+        while (!_searchFrames.empty())
         {
-            findAllUsableTrackPieces(interest, filterFunction, hashMap);
+            auto& frame = _searchFrames.back();
+            if (frame.isBlockPending)
+            {
+                frame.isBlockPending = false;
+                const auto interest = frame.interest;
+                pushTrackInBlock(interest, filterFunction, hashMap);
+                continue;
+            }
+
+            if (frame.next != frame.end)
+            {
+                const auto interest = _searchPending[frame.next++];
+                pushTrackPieces(interest, filterFunction, hashMap);
+                continue;
+            }
+
+            _searchPending.resize(frame.begin);
+            _searchFrames.pop_back();
         }
     }
 
     // 0x004A2E46
-    static void findAllTracksFilterTransform(const World::Pos3& loc, const TrackAndDirection::_TrackAndDirection trackAndDirection, const CompanyId company, const uint8_t trackType, const FilterFunction filterFunction, const TransformFunction transformFunction)
+    // Only the filter returning true for signals is used so the block found only depends on the track
+    static void findAllTracksInBlock(const LocationOfInterest& interest, LocationOfInterestHashMap& interestMap)
     {
-        _filterFunction = filterFunction;
-        _transformFunction = transformFunction;
-        LocationOfInterestHashMap interestMap{};
-        _1135F06 = &interestMap;
+        _filterFunction = isSignal;
         _1135F0A = 0;
         _1135FA6 = 5; // flags
-        findAllUsableTrackInBlock(LocationOfInterest{ loc, trackAndDirection._data, company, trackType }, filterFunction, interestMap);
-        if (reinterpret_cast<uint32_t>(transformFunction) != 0xFFFFFFFF)
+        findAllUsableTrackInBlock(interest, isSignal, interestMap);
+    }
+
+    // The track reachable from a piece without passing a signal, in the order it was found.
+    struct SignalBlock
+    {
+        std::vector<LocationOfInterest> members;
+        bool hasDeadEnd;
+    };
+
+    struct SignalBlockKey
+    {
+        World::Pos3 loc;
+        uint16_t trackAndDirection;
+        CompanyId company;
+        uint8_t trackType;
+
+        bool operator==(const SignalBlockKey& rhs) const
+        {
+            return loc == rhs.loc && trackAndDirection == rhs.trackAndDirection && company == rhs.company && trackType == rhs.trackType;
+        }
+    };
+
+    struct SignalBlockKeyHash
+    {
+        std::size_t operator()(const SignalBlockKey& key) const noexcept
+        {
+            const uint64_t packed = (static_cast<uint64_t>(static_cast<uint16_t>(key.loc.x)) << 48)
+                | (static_cast<uint64_t>(static_cast<uint16_t>(key.loc.y)) << 32)
+                | (static_cast<uint64_t>(static_cast<uint16_t>(key.loc.z)) << 16)
+                | key.trackAndDirection;
+            return std::hash<uint64_t>{}(packed ^ (static_cast<uint64_t>(enumValue(key.company)) << 8 | key.trackType));
+        }
+    };
+
+    // Blocks are kept until a game command is applied as that is the only way track and signals are
+    // built or removed. The cache is simply emptied if it ever grows too large.
+    static constexpr size_t kMaxCachedSignalBlocks = 0x2000;
+    static std::unordered_map<SignalBlockKey, SignalBlock, SignalBlockKeyHash> _signalBlocks;
+    static LocationOfInterestHashMap _interestMap;
+
+    void invalidateSignalBlocks()
+    {
+        _signalBlocks.clear();
+    }
+
+    static const SignalBlock& getSignalBlock(const World::Pos3& loc, const TrackAndDirection::_TrackAndDirection trackAndDirection, const CompanyId company, const uint8_t trackType)
+    {
+        const SignalBlockKey key{ loc, trackAndDirection._data, company, trackType };
+        auto it = _signalBlocks.find(key);
+        if (it == _signalBlocks.end())
         {
-            transformFunction(interestMap);
+            if (_signalBlocks.size() >= kMaxCachedSignalBlocks)
+            {
+                _signalBlocks.clear();
+            }
+
+            const auto oldDeadEnd = *_1136085;
+            _1136085 = 0;
+            _interestMap.clear();
+            findAllTracksInBlock(LocationOfInterest{ loc, trackAndDirection._data, company, trackType }, _interestMap);
+
+            SignalBlock block{};
+            block.hasDeadEnd = *_1136085 & (1 << 0);
+            block.members.assign(_interestMap.begin(), _interestMap.end());
+            _1136085 = oldDeadEnd;
+            it = _signalBlocks.emplace(key, std::move(block)).first;
+        }
+
+        if (it->second.hasDeadEnd)
+        {
+            _1136085 = *_1136085 | (1 << 0);
         }
+        return it->second;
     }
 
     // 0x004A2AD7
     void sub_4A2AD7(const World::Pos3& loc, const TrackAndDirection::_TrackAndDirection trackAndDirection, const CompanyId company, const uint8_t trackType)
     {
         _routingTransformData = 0;
-        findAllTracksFilterTransform(loc, trackAndDirection, company, trackType, findSignalsAndOccupation, setSignalsOccupiedState);
+        const auto& block = getSignalBlock(loc, trackAndDirection, company, trackType);
+        for (const auto& interest : block.members)
+        {
+            findSignalsAndOccupation(interest);
+        }
+        setSignalsOccupiedState(block.members);
     }
 
     uint8_t sub_4A2A58(const World::Pos3& loc, const TrackAndDirection::_TrackAndDirection trackAndDirection, const CompanyId company, const uint8_t trackType)
     {
         addr<0x001135F88, uint16_t>() = 0;
-        findAllTracksFilterTransform(loc, trackAndDirection, company, trackType, sub_4A2D4C, reinterpret_cast<TransformFunction>(0xFFFFFFFF));
+        const auto& block = getSignalBlock(loc, trackAndDirection, company, trackType);
+        for (const auto& interest : block.members)
+        {
+            sub_4A2D4C(interest);
+        }
 
         return addr<0x001135F88, uint16_t>();
     }
+
+    LocationOfInterestBenchmark benchmarkLocationOfInterestMap(size_t numLocations)
+    {
+        using Clock = std::chrono::high_resolution_clock;
+
+        // Both directions of straight track laid out over the map, stacked in height once it is full.
+        std::vector<LocationOfInterest> locations;
+        locations.reserve(numLocations);
+        for (size_t i = 0; i < numLocations; i++)
+        {
+            const auto tile = static_cast<int32_t>((i / 2) % (kMapColumns * kMapRows));
+            const auto level = static_cast<int32_t>((i / 2) / (kMapColumns * kMapRows));
+            const auto loc = World::Pos3(
+                static_cast<coord_t>((tile % kMapColumns) * kTileSize),
+                static_cast<coord_t>((tile / kMapColumns) * kTileSize),
+                static_cast<coord_t>(level * kSmallZStep));
+            TrackAndDirection::_TrackAndDirection tad(0, 0);
+            tad.setReversed(i % 2 != 0);
+            locations.push_back(LocationOfInterest{ loc, tad._data, CompanyId(0), 0 });
+        }
+
+        LocationOfInterestHashMap map;
+        LocationOfInterestBenchmark result{};
+
+        const auto insertStarted = Clock::now();
+        for (const auto& interest : locations)
+        {
+            map.tryAdd(interest);
+        }
+        result.insertNs = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - insertStarted).count();
+
+        const auto lookupStarted = Clock::now();
+        for (const auto& interest : locations)
+        {
+            if (map.contains(interest))
+            {
+                result.numFound++;
+            }
+        }
+        result.lookupNs = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - lookupStarted).count();
+        return result;
+    }
 }
@@ -1,5 +1,6 @@
 #pragma once
 #include "Engine/Limits.h"
+#include <cstddef>
 #include <cstdint>
 
 namespace OpenLoco::Vehicles
@@ -26,4 +27,15 @@ namespace OpenLoco::Vehicles
     };
     static_assert(sizeof(RoutingHandle) == 2);
 #pragma pack(pop)
+
+    struct LocationOfInterestBenchmark
+    {
+        uint64_t insertNs;
+        uint64_t lookupNs;
+        size_t numFound;
+    };
+
+    // Times adding the given number of distinct locations to the map used by the track searches
+    // and then looking each of them up again.
+    LocationOfInterestBenchmark benchmarkLocationOfInterestMap(size_t numLocations);
 }
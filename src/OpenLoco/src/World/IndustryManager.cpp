@@ -13,15 +13,20 @@
 #include "Objects/IndustryObject.h"
 #include "Objects/ObjectManager.h"
 #include "Random.h"
+#include "ScenarioManager.h"
 #include "SceneManager.h"
 #include "TownManager.h"
 #include "Ui/WindowManager.h"
 #include <OpenLoco/Math/Vector.hpp>
 #include <numeric>
+#include <optional>
 
 namespace OpenLoco::IndustryManager
 {
     static auto& rawIndustries() { return getGameState().industries; }
+
+    static OccupancyMask<Limits::kMaxIndustries> _occupancy;
+    static std::optional<uint32_t> _occupancyTick;
     static auto getTotalIndustriesCap() { return getGameState().numberOfIndustries; }
     Flags getFlags() { return getGameState().industryFlags; }
 
@@ -61,12 +66,26 @@ namespace OpenLoco::IndustryManager
         {
             industry.name = StringIds::null;
         }
+        invalidateOccupancy();
         Ui::Windows::IndustryList::reset();
     }
 
     FixedVector<Industry, Limits::kMaxIndustries> industries()
     {
-        return FixedVector(rawIndustries());
+        // Industries are only created by game commands, refreshing once per tick and whenever
+        // invalidated is enough to always include every industry.
+        const auto tick = ScenarioManager::getScenarioTicks();
+        if (_occupancyTick != tick)
+        {
+            _occupancyTick = tick;
+            _occupancy.assign(rawIndustries());
+        }
+        return FixedVector(rawIndustries(), _occupancy);
+    }
+
+    void invalidateOccupancy()
+    {
+        _occupancyTick = std::nullopt;
     }
 
     Industry* get(IndustryId id)
@@ -20,6 +20,8 @@ namespace OpenLoco::IndustryManager
 
     void reset();
     FixedVector<Industry, Limits::kMaxIndustries> industries();
+    // Must be called when industries may have been created within a tick, e.g. after a game command.
+    void invalidateOccupancy();
     Industry* get(IndustryId id);
     Flags getFlags();
     bool hasFlags(const Flags flags);
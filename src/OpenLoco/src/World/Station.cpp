@@ -34,6 +34,23 @@ namespace OpenLoco
     constexpr uint8_t kMaxCargoRating = 200;
     constexpr uint8_t catchmentSize = 4;
 
+    // Inclusive tile bounds containing every tile that has a catchment flag set.
+    struct CatchmentBounds
+    {
+        tile_coord_t minX;
+        tile_coord_t minY;
+        tile_coord_t maxX;
+        tile_coord_t maxY;
+
+        bool empty() const
+        {
+            return minX > maxX || minY > maxY;
+        }
+    };
+
+    constexpr CatchmentBounds kEmptyCatchmentBounds = { kMapColumns, kMapRows, -1, -1 };
+    constexpr CatchmentBounds kFullCatchmentBounds = { 0, 0, kMapColumns - 1, kMapRows - 1 };
+
     struct CargoSearchState
     {
     private:
@@ -44,7 +61,25 @@ namespace OpenLoco
         inline static loco_global<IndustryId[kMaxCargoStats], 0x0112C7D2> _industry;
         inline static loco_global<uint8_t, 0x0112C7F2> _byte_112C7F2;
 
+        // Not part of the original, lets searches skip the parts of the map that have no flags set.
+        // Starts as the whole map as nothing is known about the map contents yet.
+        inline static CatchmentBounds _bounds[2] = { kFullCatchmentBounds, kFullCatchmentBounds };
+
+        void extendBounds(const CatchmentFlags flag, tile_coord_t minX, tile_coord_t minY, tile_coord_t maxX, tile_coord_t maxY)
+        {
+            auto& bounds = _bounds[enumValue(flag)];
+            bounds.minX = std::min(bounds.minX, minX);
+            bounds.minY = std::min(bounds.minY, minY);
+            bounds.maxX = std::max(bounds.maxX, maxX);
+            bounds.maxY = std::max(bounds.maxY, maxY);
+        }
+
     public:
+        const CatchmentBounds& bounds(const CatchmentFlags flag) const
+        {
+            return _bounds[enumValue(flag)];
+        }
+
         bool mapHas2(const tile_coord_t x, const tile_coord_t y) const
         {
             return (_map[y * kMapColumns + x] & (1 << enumValue(CatchmentFlags::flag_1))) != 0;
@@ -57,6 +92,7 @@ namespace OpenLoco
 
         void setTile(const tile_coord_t x, const tile_coord_t y, const CatchmentFlags flag)
         {
+            extendBounds(flag, x, y, x, y);
             _map[y * kMapColumns + x] |= (1 << enumValue(flag));
         }
 
@@ -67,13 +103,19 @@ namespace OpenLoco
 
         void setTileRegion(tile_coord_t x, tile_coord_t y, int16_t xTileCount, int16_t yTileCount, const CatchmentFlags flag)
         {
+            if (xTileCount <= 0 || yTileCount <= 0)
+            {
+                return;
+            }
+            extendBounds(flag, x, y, x + xTileCount - 1, y + yTileCount - 1);
+
             auto xStart = x;
             auto xTileStartCount = xTileCount;
             while (yTileCount > 0)
             {
                 while (xTileCount > 0)
                 {
-                    setTile(x, y, flag);
+                    _map[y * kMapColumns + x] |= (1 << enumValue(flag));
                     x++;
                     xTileCount--;
                 }
@@ -87,6 +129,24 @@ namespace OpenLoco
 
         void resetTileRegion(tile_coord_t x, tile_coord_t y, int16_t xTileCount, int16_t yTileCount, const CatchmentFlags flag)
         {
+            // Only the part of the region that can have the flag set needs visiting.
+            auto& bounds = _bounds[enumValue(flag)];
+            const tile_coord_t maxX = std::min<tile_coord_t>(x + xTileCount - 1, bounds.maxX);
+            const tile_coord_t maxY = std::min<tile_coord_t>(y + yTileCount - 1, bounds.maxY);
+            const bool coversBounds = x <= bounds.minX && y <= bounds.minY && maxX == bounds.maxX && maxY == bounds.maxY;
+            x = std::max(x, bounds.minX);
+            y = std::max(y, bounds.minY);
+            xTileCount = maxX - x + 1;
+            yTileCount = maxY - y + 1;
+            if (coversBounds)
+            {
+                bounds = kEmptyCatchmentBounds;
+            }
+            if (xTileCount <= 0 || yTileCount <= 0)
+            {
+                return;
+            }
+
             auto xStart = x;
             auto xTileStartCount = xTileCount;
             while (yTileCount > 0)
@@ -274,9 +334,11 @@ namespace OpenLoco
             cargoSearchState.filter(~0);
         }
 
-        for (tile_coord_t ty = 0; ty < kMapColumns; ty++)
+        // Only the tiles within the catchment can have the flag set, visiting them in the same order as the whole map.
+        const auto bounds = cargoSearchState.bounds(CatchmentFlags::flag_1);
+        for (tile_coord_t ty = bounds.minY; ty <= bounds.maxY; ty++)
         {
-            for (tile_coord_t tx = 0; tx < kMapRows; tx++)
+            for (tile_coord_t tx = bounds.minX; tx <= bounds.maxX; tx++)
             {
                 if (cargoSearchState.mapHas2(tx, ty))
                 {
@@ -816,23 +878,16 @@ namespace OpenLoco
         auto tile = TileManager::get(pos.x, pos.y);
         auto baseZ = pos.z / 4;
 
-        for (auto& element : tile)
+        for (auto& stationElement : tile.elementsOfType<StationElement>())
         {
-            auto* stationElement = element.as<StationElement>();
-
-            if (stationElement == nullptr)
-            {
-                continue;
-            }
-
-            if (stationElement->baseZ() != baseZ)
+            if (stationElement.baseZ() != baseZ)
             {
                 continue;
             }
 
-            if (!stationElement->isFlag5())
+            if (!stationElement.isFlag5())
             {
-                return stationElement;
+                return &stationElement;
             }
             else
             {
@@ -10,16 +10,24 @@
 #include "Map/StationElement.h"
 #include "Map/SurfaceElement.h"
 #include "Map/TileManager.h"
+#include "Objects/AirportObject.h"
 #include "Objects/IndustryObject.h"
+#include "Objects/ObjectManager.h"
 #include "ScenarioManager.h"
 #include "SceneManager.h"
 #include "TownManager.h"
 #include "Ui/WindowManager.h"
 #include "Window.h"
+#include <OpenLoco/Core/Hash.h>
+#include <OpenLoco/Core/Span.hpp>
 #include <OpenLoco/Interop/Interop.hpp>
 
+#include <algorithm>
+#include <array>
 #include <bitset>
 #include <numeric>
+#include <optional>
+#include <tuple>
 
 using namespace OpenLoco::Interop;
 using namespace OpenLoco::Ui;
@@ -29,6 +37,9 @@ namespace OpenLoco::StationManager
 {
     static auto& rawStations() { return getGameState().stations; }
 
+    static OccupancyMask<Limits::kMaxStations> _occupancy;
+    static std::optional<uint32_t> _occupancyTick;
+
     // 0x0048B1D8
     void reset()
     {
@@ -36,12 +47,26 @@ namespace OpenLoco::StationManager
         {
             station.name = StringIds::null;
         }
+        invalidateOccupancy();
         Ui::Windows::Station::reset();
     }
 
     FixedVector<Station, Limits::kMaxStations> stations()
     {
-        return FixedVector(rawStations());
+        // Stations are only created by game commands, refreshing once per tick and whenever
+        // invalidated after an applied command is enough to include every station but ghosts.
+        const auto tick = ScenarioManager::getScenarioTicks();
+        if (_occupancyTick != tick)
+        {
+            _occupancyTick = tick;
+            _occupancy.assign(rawStations());
+        }
+        return FixedVector(rawStations(), _occupancy);
+    }
+
+    void invalidateOccupancy()
+    {
+        _occupancyTick = std::nullopt;
     }
 
     Station* get(StationId id)
@@ -424,7 +449,7 @@ namespace OpenLoco::StationManager
         }
     }
 
-    static uint16_t deliverCargoToStations(const std::vector<std::pair<StationId, uint8_t>>& foundStations, const uint8_t cargoType, const uint8_t cargoQty)
+    static uint16_t deliverCargoToStations(stdx::span<const std::pair<StationId, uint8_t>> foundStations, const uint8_t cargoType, const uint8_t cargoQty)
     {
         if (foundStations.empty())
         {
@@ -460,63 +485,282 @@ namespace OpenLoco::StationManager
         return std::min<uint16_t>(cargoQtyDelivered, cargoQty);
     }
 
-    // 0x0042F2FE
-    uint16_t deliverCargoToNearbyStations(const uint8_t cargoType, const uint8_t cargoQty, const World::Pos2& pos, const World::TilePos2& size)
+    // Persistent index of where stations have elements so that delivering cargo does not need to
+    // search every tile around the producer. The map is split into cells and each cell lists the
+    // stations with elements inside of it. Stations are reindexed when their station tiles change.
+    namespace Coverage
     {
-        const auto initialLoc = World::toTileSpace(pos) - TilePos2(4, 4);
-        const auto catchmentSize = size + TilePos2(8, 8);
-        // TODO: Use a fixed size array (max size 15)
-        std::vector<std::pair<StationId, uint8_t>> foundStations;
-        for (TilePos2 searchOffset{ 0, 0 }; searchOffset.y < catchmentSize.y; ++searchOffset.y)
+        constexpr tile_coord_t kCellSize = 8;
+        constexpr int32_t kCellColumns = (kMapColumns + kCellSize - 1) / kCellSize;
+        constexpr int32_t kCellRows = (kMapRows + kCellSize - 1) / kCellSize;
+
+        // Inclusive tile rectangle
+        struct TileRect
         {
-            for (; searchOffset.x < catchmentSize.x; ++searchOffset.x)
+            tile_coord_t minX;
+            tile_coord_t minY;
+            tile_coord_t maxX;
+            tile_coord_t maxY;
+
+            bool empty() const
             {
-                const auto searchLoc = initialLoc + searchOffset;
-                if (!World::validCoords(searchLoc))
+                return minX > maxX || minY > maxY;
+            }
+
+            TileRect intersect(const TileRect& other) const
+            {
+                return TileRect{ std::max(minX, other.minX), std::max(minY, other.minY), std::min(maxX, other.maxX), std::min(maxY, other.maxY) };
+            }
+
+            void extend(const TilePos2& min, const TilePos2& max)
+            {
+                minX = std::min(minX, min.x);
+                minY = std::min(minY, min.y);
+                maxX = std::max(maxX, max.x);
+                maxY = std::max(maxY, max.y);
+            }
+        };
+
+        constexpr TileRect kEmptyRect = { kMapColumns, kMapRows, -1, -1 };
+
+        struct StationEntry
+        {
+            uint64_t fingerprint = 0;
+            TileRect extents = kEmptyRect; // All tiles that can hold an element of the station
+        };
+
+        static std::array<std::vector<StationId>, kCellColumns * kCellRows> _cells;
+        static std::array<StationEntry, Limits::kMaxStations> _entries;
+        static std::array<uint32_t, Limits::kMaxStations> _candidateMarks;
+        static uint32_t _candidateMark = 0;
+        static std::optional<uint32_t> _validatedTick;
+
+        static TileRect getCellRect(const TileRect& rect)
+        {
+            return TileRect{
+                static_cast<tile_coord_t>(std::max<tile_coord_t>(rect.minX, 0) / kCellSize),
+                static_cast<tile_coord_t>(std::max<tile_coord_t>(rect.minY, 0) / kCellSize),
+                static_cast<tile_coord_t>(std::min<tile_coord_t>(rect.maxX, kMapColumns - 1) / kCellSize),
+                static_cast<tile_coord_t>(std::min<tile_coord_t>(rect.maxY, kMapRows - 1) / kCellSize),
+            };
+        }
+
+        template<typename TFunc>
+        static void forEachCell(const TileRect& rect, TFunc&& func)
+        {
+            if (rect.empty())
+            {
+                return;
+            }
+            const auto cells = getCellRect(rect);
+            for (auto y = cells.minY; y <= cells.maxY; y++)
+            {
+                for (auto x = cells.minX; x <= cells.maxX; x++)
                 {
-                    continue;
+                    func(_cells[y * kCellColumns + x]);
                 }
+            }
+        }
 
-                const auto tile = TileManager::get(searchLoc);
-                for (const auto& el : tile)
-                {
-                    auto* elStation = el.as<StationElement>();
-                    if (elStation == nullptr)
-                    {
-                        continue;
-                    }
+        static uint64_t getFingerprint(const Station& station)
+        {
+            if (station.empty())
+            {
+                return 0;
+            }
+            return Core::hash64(station.stationTiles, station.stationTileSize * sizeof(Pos3), station.stationTileSize + 1);
+        }
 
-                    if (elStation->isFlag5() || elStation->isGhost())
-                    {
-                        continue;
-                    }
+        // Airports and docks only list a single station tile but have elements on all the tiles they occupy.
+        static TileRect getStationExtents(const Station& station)
+        {
+            auto extents = kEmptyRect;
+            for (uint16_t i = 0; i < station.stationTileSize; i++)
+            {
+                const auto pos = station.stationTiles[i];
+                const auto tilePos = World::toTileSpace(pos);
+                auto minPos = tilePos;
+                auto maxPos = tilePos;
 
-                    if (foundStations.size() > 15)
+                const auto baseZ = (pos.z & ~((1 << 1) | (1 << 0))) / 4;
+                for (const auto& el : TileManager::get(tilePos))
+                {
+                    const auto* elStation = el.as<StationElement>();
+                    if (elStation == nullptr || elStation->baseZ() != baseZ)
                     {
-                        break;
+                        continue;
                     }
-                    auto res = std::find_if(foundStations.begin(), foundStations.end(), [stationId = elStation->stationId()](const std::pair<StationId, uint8_t>& item) { return item.first == stationId; });
-                    if (res != foundStations.end())
+                    if (elStation->stationType() == StationType::airport)
                     {
-                        continue;
+                        auto* airportObject = ObjectManager::get<AirportObject>(elStation->objectId());
+                        std::tie(minPos, maxPos) = airportObject->getAirportExtents(tilePos, elStation->rotation());
                     }
-                    auto* station = get(elStation->stationId());
-                    if (station == nullptr)
+                    else if (elStation->stationType() == StationType::docks)
                     {
-                        continue;
+                        maxPos += TilePos2{ 1, 1 };
                     }
-                    if ((station->cargoStats[cargoType].flags & StationCargoStatsFlags::flag1) == StationCargoStatsFlags::none)
+                    break;
+                }
+                extents.extend(minPos, maxPos);
+            }
+            return extents;
+        }
+
+        static void removeStation(StationId id)
+        {
+            auto& entry = _entries[enumValue(id)];
+            forEachCell(entry.extents, [id](std::vector<StationId>& cell) {
+                cell.erase(std::remove(cell.begin(), cell.end(), id), cell.end());
+            });
+            entry = StationEntry{};
+        }
+
+        static void addStation(const Station& station)
+        {
+            auto& entry = _entries[enumValue(station.id())];
+            entry.fingerprint = getFingerprint(station);
+            entry.extents = getStationExtents(station);
+            forEachCell(entry.extents, [id = station.id()](std::vector<StationId>& cell) {
+                cell.push_back(id);
+            });
+        }
+
+        // Station tiles are only changed by game commands, checking once per tick and after every
+        // applied game command is enough to be up to date apart from ghosts.
+        static void validate()
+        {
+            const auto tick = ScenarioManager::getScenarioTicks();
+            if (_validatedTick == tick)
+            {
+                return;
+            }
+            _validatedTick = tick;
+
+            for (auto& station : rawStations())
+            {
+                const auto id = station.id();
+                if (getFingerprint(station) == _entries[enumValue(id)].fingerprint)
+                {
+                    continue;
+                }
+                removeStation(id);
+                if (!station.empty())
+                {
+                    addStation(station);
+                }
+            }
+        }
+
+        struct FoundStation
+        {
+            tile_coord_t y;
+            tile_coord_t x;
+            const TileElement* element;
+            StationId id;
+            uint8_t rating;
+        };
+
+        // Finds the first element of the station within the rect in the same order as searching tile by tile.
+        static const TileElement* findFirstElement(StationId id, const TileRect& rect, TilePos2& foundPos)
+        {
+            for (auto y = rect.minY; y <= rect.maxY; y++)
+            {
+                for (auto x = rect.minX; x <= rect.maxX; x++)
+                {
+                    for (const auto& elStation : TileManager::get(TilePos2{ x, y }).elementsOfType<StationElement>())
                     {
-                        continue;
+                        if (elStation.stationId() != id || elStation.isFlag5() || elStation.isGhost())
+                        {
+                            continue;
+                        }
+                        foundPos = TilePos2{ x, y };
+                        return reinterpret_cast<const TileElement*>(&elStation);
                     }
+                }
+            }
+            return nullptr;
+        }
+    }
+
+    void invalidateCoverage()
+    {
+        Coverage::_validatedTick = std::nullopt;
+    }
+
+    // 0x0042F2FE
+    uint16_t deliverCargoToNearbyStations(const uint8_t cargoType, const uint8_t cargoQty, const World::Pos2& pos, const World::TilePos2& size)
+    {
+        using namespace Coverage;
+
+        const auto initialLoc = World::toTileSpace(pos) - TilePos2(4, 4);
+        const auto catchmentSize = size + TilePos2(8, 8);
+        const TileRect searchRect{ initialLoc.x, initialLoc.y, static_cast<tile_coord_t>(initialLoc.x + catchmentSize.x - 1), static_cast<tile_coord_t>(initialLoc.y + catchmentSize.y - 1) };
+
+        validate();
+
+        // Stations are delivered to in the order their first element is found when searching the
+        // catchment tile by tile, up to a maximum of 16 stations. Only the first 16 are kept, sorted
+        // as they are found, so no allocation is needed however many stations the cells list.
+        constexpr size_t kMaxStations = 16;
+        const auto isFoundBefore = [](const FoundStation& a, const FoundStation& b) {
+            return std::tie(a.y, a.x, a.element) < std::tie(b.y, b.x, b.element);
+        };
+        std::array<FoundStation, kMaxStations> candidates;
+        size_t numCandidates = 0;
+
+        _candidateMark++;
+        forEachCell(searchRect, [&](const std::vector<StationId>& cell) {
+            for (auto id : cell)
+            {
+                auto& mark = _candidateMarks[enumValue(id)];
+                if (mark == _candidateMark)
+                {
+                    continue;
+                }
+                mark = _candidateMark;
+
+                auto* station = get(id);
+                if ((station->cargoStats[cargoType].flags & StationCargoStatsFlags::flag1) == StationCargoStatsFlags::none)
+                {
+                    continue;
+                }
+
+                const auto rect = _entries[enumValue(id)].extents.intersect(searchRect);
+                if (rect.empty())
+                {
+                    continue;
+                }
+
+                TilePos2 foundPos;
+                const auto* element = findFirstElement(id, rect, foundPos);
+                if (element == nullptr)
+                {
+                    continue;
+                }
 
-                    foundStations.push_back(std::make_pair(elStation->stationId(), station->cargoStats[cargoType].rating));
+                const FoundStation found{ foundPos.y, foundPos.x, element, id, station->cargoStats[cargoType].rating };
+                if (numCandidates == kMaxStations && !isFoundBefore(found, candidates.back()))
+                {
+                    continue;
+                }
+                const auto end = candidates.begin() + numCandidates;
+                const auto it = std::upper_bound(candidates.begin(), end, found, isFoundBefore);
+                if (numCandidates < kMaxStations)
+                {
+                    numCandidates++;
                 }
+                std::move_backward(it, candidates.begin() + numCandidates - 1, candidates.begin() + numCandidates);
+                *it = found;
             }
-            searchOffset.x = 0;
+        });
+
+        std::array<std::pair<StationId, uint8_t>, kMaxStations> foundStations;
+        for (size_t i = 0; i < numCandidates; i++)
+        {
+            foundStations[i] = std::make_pair(candidates[i].id, candidates[i].rating);
         }
 
-        return deliverCargoToStations(foundStations, cargoType, cargoQty);
+        return deliverCargoToStations(stdx::span<const std::pair<StationId, uint8_t>>(foundStations.data(), numCandidates), cargoType, cargoQty);
     }
 
     // 0x0042F2BF
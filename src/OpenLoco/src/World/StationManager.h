@@ -11,6 +11,8 @@ namespace OpenLoco::StationManager
 {
     void reset();
     FixedVector<Station, Limits::kMaxStations> stations();
+    // Must be called when stations may have been created within a tick, e.g. after a game command.
+    void invalidateOccupancy();
     Station* get(StationId id);
     void update();
     void updateLabels();
@@ -19,6 +21,8 @@ namespace OpenLoco::StationManager
     string_id generateNewStationName(StationId stationId, TownId townId, World::Pos3 position, uint8_t mode);
     void zeroUnused();
     void registerHooks();
+    // Must be called when station tiles may have changed within a tick, e.g. after a game command.
+    void invalidateCoverage();
     uint16_t deliverCargoToNearbyStations(const uint8_t cargoType, const uint8_t cargoQty, const World::Pos2& pos, const World::TilePos2& size);
     uint16_t deliverCargoToStations(const std::vector<StationId>& stations, const uint8_t cargoType, const uint8_t cargoQty);
 }
@@ -11,8 +11,10 @@
 #include "ScenarioManager.h"
 #include "SceneManager.h"
 #include "Ui/WindowManager.h"
+#include <OpenLoco/Core/Hash.h>
 #include <OpenLoco/Core/Numerics.hpp>
 #include <OpenLoco/Interop/Interop.hpp>
+#include <vector>
 
 using namespace OpenLoco::Interop;
 
@@ -69,9 +71,14 @@ namespace OpenLoco::TownManager
 
     static auto& rawTowns() { return getGameState().towns; }
 
+    static OccupancyMask<Limits::kMaxTowns> _occupancy;
+    static std::optional<uint32_t> _occupancyTick;
+
     // 0x00497348
     void resetBuildingsInfluence()
     {
+        invalidateOccupancy();
+
         for (auto& town : towns())
         {
             town.numBuildings = 0;
@@ -130,12 +137,21 @@ namespace OpenLoco::TownManager
         {
             town.name = StringIds::null;
         }
+        invalidateOccupancy();
         Ui::Windows::TownList::reset();
     }
 
     FixedVector<Town, Limits::kMaxTowns> towns()
     {
-        return FixedVector(rawTowns());
+        // Towns are only created by game commands, refreshing once per tick and whenever
+        // invalidated is enough to always include every town.
+        const auto tick = ScenarioManager::getScenarioTicks();
+        if (_occupancyTick != tick)
+        {
+            _occupancyTick = tick;
+            _occupancy.assign(rawTowns());
+        }
+        return FixedVector(rawTowns(), _occupancy);
     }
 
     Town* get(TownId id)
@@ -186,19 +202,132 @@ namespace OpenLoco::TownManager
         Ui::WindowManager::invalidate(Ui::WindowType::town);
     }
 
+    // Grid of candidate towns for getClosestTownAndDensity. Each cell lists every town that can be the
+    // closest one for some position within the cell, so a lookup only compares a couple of towns.
+    namespace ClosestTownGrid
+    {
+        constexpr coord_t kCellSize = 8 * World::kTileSize;
+        constexpr int32_t kCellColumns = World::kMapWidth / kCellSize;
+        constexpr int32_t kCellRows = World::kMapHeight / kCellSize;
+        static_assert(World::kMapWidth % kCellSize == 0 && World::kMapHeight % kCellSize == 0);
+
+        static std::array<uint32_t, kCellColumns * kCellRows + 1> _cellOffsets;
+        static std::vector<TownId> _candidates;
+        static std::optional<uint64_t> _fingerprint;
+        static std::optional<uint32_t> _validatedTick;
+
+        // Only the towns that exist and their positions determine the closest town.
+        static uint64_t getFingerprint()
+        {
+            std::array<uint32_t, Limits::kMaxTowns> positions;
+            positions.fill(std::numeric_limits<uint32_t>::max());
+            for (const auto& town : towns())
+            {
+                positions[enumValue(town.id())] = (static_cast<uint16_t>(town.x) << 16) | static_cast<uint16_t>(town.y);
+            }
+            return Core::hash64(positions.data(), sizeof(positions));
+        }
+
+        static void rebuild()
+        {
+            _candidates.clear();
+
+            std::array<int32_t, Limits::kMaxTowns> minDistances{};
+            for (int32_t cellY = 0; cellY < kCellRows; cellY++)
+            {
+                for (int32_t cellX = 0; cellX < kCellColumns; cellX++)
+                {
+                    const int32_t x0 = cellX * kCellSize;
+                    const int32_t y0 = cellY * kCellSize;
+                    const int32_t x1 = x0 + kCellSize - 1;
+                    const int32_t y1 = y0 + kCellSize - 1;
+
+                    // A town can only be the closest if its distance to the nearest point of the cell is not
+                    // greater than the distance of another town to the furthest point of the cell.
+                    int32_t bestMaxDistance = std::numeric_limits<int32_t>::max();
+                    for (const auto& town : towns())
+                    {
+                        const auto dx = std::max(x0 - town.x, std::max(town.x - x1, 0));
+                        const auto dy = std::max(y0 - town.y, std::max(town.y - y1, 0));
+                        minDistances[enumValue(town.id())] = dx + dy;
+
+                        const auto maxDx = std::max(std::abs(town.x - x0), std::abs(town.x - x1));
+                        const auto maxDy = std::max(std::abs(town.y - y0), std::abs(town.y - y1));
+                        bestMaxDistance = std::min(bestMaxDistance, maxDx + maxDy);
+                    }
+
+                    _cellOffsets[cellY * kCellColumns + cellX] = static_cast<uint32_t>(_candidates.size());
+                    for (const auto& town : towns())
+                    {
+                        if (minDistances[enumValue(town.id())] <= bestMaxDistance)
+                        {
+                            _candidates.push_back(town.id());
+                        }
+                    }
+                }
+            }
+            _cellOffsets.back() = static_cast<uint32_t>(_candidates.size());
+        }
+
+        // Towns are only created and removed by game commands, checking once per tick and whenever
+        // invalidated is enough to always be up to date.
+        static void validate()
+        {
+            const auto tick = ScenarioManager::getScenarioTicks();
+            if (_validatedTick == tick)
+            {
+                return;
+            }
+            _validatedTick = tick;
+
+            const auto fingerprint = getFingerprint();
+            if (fingerprint != _fingerprint)
+            {
+                _fingerprint = fingerprint;
+                rebuild();
+            }
+        }
+    }
+
+    void invalidateOccupancy()
+    {
+        _occupancyTick = std::nullopt;
+        ClosestTownGrid::_validatedTick = std::nullopt;
+    }
+
     // 0x00497E52
     std::optional<std::pair<TownId, uint8_t>> getClosestTownAndDensity(const World::Pos2& loc)
     {
+        using namespace ClosestTownGrid;
+
         int32_t closestDistance = std::numeric_limits<uint16_t>::max();
         auto closestTown = TownId::null; // ebx
-        for (const auto& town : towns())
-        {
+        const auto considerTown = [&](const Town& town) {
             const auto distance = Math::Vector::manhattanDistance(World::Pos2(town.x, town.y), loc);
             if (distance < closestDistance)
             {
                 closestDistance = distance;
                 closestTown = town.id();
             }
+        };
+
+        if (World::validCoords(loc))
+        {
+            validate();
+
+            // Candidates are in the same order as towns() so ties resolve to the same town.
+            const auto cell = (loc.y / kCellSize) * kCellColumns + (loc.x / kCellSize);
+            for (auto i = _cellOffsets[cell]; i < _cellOffsets[cell + 1]; i++)
+            {
+                considerTown(*get(_candidates[i]));
+            }
+        }
+        else
+        {
+            for (const auto& town : towns())
+            {
+                considerTown(town);
+            }
         }
 
         if (closestDistance == std::numeric_limits<uint16_t>::max())
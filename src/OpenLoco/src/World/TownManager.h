@@ -12,6 +12,8 @@ namespace OpenLoco::TownManager
     FixedVector<Town, Limits::kMaxTowns> towns();
     Town* get(TownId id);
     std::optional<std::pair<TownId, uint8_t>> getClosestTownAndDensity(const World::Pos2& loc);
+    // Must be called when towns may have been created or removed within a tick.
+    void invalidateOccupancy();
     void update();
     void updateLabels();
     void updateMonthly();